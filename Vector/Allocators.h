@@ -0,0 +1,457 @@
+#pragma once
+
+#include "Vector.h"
+#include <cstdint>
+#include <new>
+
+namespace miv
+{
+	// Монотонная арена: выделение сдвигом указателя, освобождение только
+	// целиком через reset()/release(). Не потокобезопасна.
+	class Arena
+	{
+	public:
+		explicit Arena(std::size_t chunk_size = 64 * 1024) noexcept
+			: head_(nullptr), cur_(nullptr), end_(nullptr), last_(nullptr),
+			  chunk_size_(chunk_size), used_(0)
+		{
+		}
+
+		Arena(const Arena &) = delete;
+		Arena &operator=(const Arena &) = delete;
+
+		~Arena()
+		{
+			release();
+		}
+
+		void *allocate(std::size_t bytes, std::size_t align)
+		{
+			// Выравнивание может увести p за end_: сравниваем адреса как числа
+			char *p = align_up(cur_, align);
+			auto pv = reinterpret_cast<std::uintptr_t>(p), ev = reinterpret_cast<std::uintptr_t>(end_);
+			if (!cur_ || pv > ev || bytes > ev - pv)
+			{
+				add_chunk(bytes + align);
+				p = align_up(cur_, align);
+			}
+			cur_ = p + bytes;
+			last_ = p;
+			used_ += bytes;
+			return p;
+		}
+
+		// Память возвращается только reset()/release()
+		void deallocate(void *, std::size_t) noexcept
+		{
+		}
+
+		// Последний выделенный блок можно растить на месте, пока хватает чанка
+		bool try_expand(void *p, std::size_t old_bytes, std::size_t new_bytes) noexcept
+		{
+			if (p != last_ || static_cast<char *>(p) + old_bytes != cur_)
+				return false;
+			if (new_bytes - old_bytes > static_cast<std::size_t>(end_ - cur_))
+				return false;
+			cur_ += new_bytes - old_bytes;
+			used_ += new_bytes - old_bytes;
+			return true;
+		}
+
+		// Сбросить всё выделенное, оставив первый чанк для повторного использования.
+		// Векторы с тривиально разрушаемыми T после reset() можно не разрушать.
+		void reset() noexcept
+		{
+			if (!head_)
+				return;
+			Chunk *keep = head_;
+			while (keep->next)
+				keep = keep->next;
+			free_chunks(head_, keep);
+			head_ = keep;
+			cur_ = keep->data();
+			end_ = cur_ + keep->size;
+			last_ = nullptr;
+			used_ = 0;
+		}
+
+		// Вернуть все чанки системе
+		void release() noexcept
+		{
+			free_chunks(head_, nullptr);
+			head_ = nullptr;
+			cur_ = end_ = last_ = nullptr;
+			used_ = 0;
+		}
+
+		std::size_t bytes_used() const noexcept { return used_; }
+
+	private:
+		struct Chunk
+		{
+			Chunk *next;
+			std::size_t size;
+			char *data() noexcept { return reinterpret_cast<char *>(this + 1); }
+		};
+
+		Chunk *head_; // последний добавленный чанк, список идёт к первому
+		char *cur_, *end_, *last_;
+		std::size_t chunk_size_, used_;
+
+		static char *align_up(char *p, std::size_t align) noexcept
+		{
+			auto v = reinterpret_cast<std::uintptr_t>(p);
+			return reinterpret_cast<char *>((v + align - 1) & ~(std::uintptr_t(align) - 1));
+		}
+
+		void add_chunk(std::size_t min_bytes)
+		{
+			std::size_t size = std::max(chunk_size_, min_bytes);
+			auto *c = static_cast<Chunk *>(::operator new(sizeof(Chunk) + size));
+			c->next = head_;
+			c->size = size;
+			head_ = c;
+			cur_ = c->data();
+			end_ = cur_ + size;
+			// следующие чанки растут геометрически, но не больше 16 MiB
+			chunk_size_ = std::min<std::size_t>(chunk_size_ * 2, std::size_t(16) << 20);
+		}
+
+		static void free_chunks(Chunk *c, Chunk *stop) noexcept
+		{
+			while (c != stop)
+			{
+				Chunk *next = c->next;
+				::operator delete(c);
+				c = next;
+			}
+		}
+	};
+
+	// Пул с классами размеров (степени двойки от 8 байт до 4 KiB): освобождённые
+	// блоки уходят в свободный список своего класса. Крупные запросы идут
+	// напрямую в ::operator new. Не потокобезопасен.
+	class Pool
+	{
+	public:
+		static constexpr std::size_t min_class = 8;
+		static constexpr std::size_t max_class = 4096;
+		static constexpr std::size_t class_count = 10;
+
+		explicit Pool(std::size_t slab_size = 64 * 1024) noexcept
+			: slabs_(nullptr), slab_size_(slab_size)
+		{
+			std::fill_n(free_, class_count, nullptr);
+		}
+
+		Pool(const Pool &) = delete;
+		Pool &operator=(const Pool &) = delete;
+
+		~Pool()
+		{
+			release();
+		}
+
+		void *allocate(std::size_t bytes, std::size_t align)
+		{
+			if (bytes > max_class || align > alignof(std::max_align_t))
+				return ::operator new(bytes, std::align_val_t(std::max(align, alignof(std::max_align_t))));
+			std::size_t c = class_of(bytes);
+			if (!free_[c])
+				refill(c);
+			Node *n = free_[c];
+			free_[c] = n->next;
+			return n;
+		}
+
+		void deallocate(void *p, std::size_t bytes, std::size_t align) noexcept
+		{
+			if (bytes > max_class || align > alignof(std::max_align_t))
+				return ::operator delete(p, std::align_val_t(std::max(align, alignof(std::max_align_t))));
+			std::size_t c = class_of(bytes);
+			Node *n = static_cast<Node *>(p);
+			n->next = free_[c];
+			free_[c] = n;
+		}
+
+		// Вернуть все слэбы системе; блоки, выданные из пула, становятся недействительными
+		void release() noexcept
+		{
+			while (slabs_)
+			{
+				Node *next = slabs_->next;
+				::operator delete(slabs_);
+				slabs_ = next;
+			}
+			std::fill_n(free_, class_count, nullptr);
+		}
+
+	private:
+		struct Node
+		{
+			Node *next;
+		};
+
+		Node *free_[class_count];
+		Node *slabs_;
+		std::size_t slab_size_;
+
+		static std::size_t class_of(std::size_t bytes) noexcept
+		{
+			std::size_t c = 0, sz = min_class;
+			while (sz < bytes)
+			{
+				sz <<= 1;
+				++c;
+			}
+			return c;
+		}
+
+		// Нарезать новый слэб на блоки класса c
+		void refill(std::size_t c)
+		{
+			std::size_t block = min_class << c;
+			std::size_t count = std::max<std::size_t>(slab_size_ / block, 1);
+			// первый блок слэба занят заголовком списка слэбов
+			char *slab = static_cast<char *>(::operator new(block * (count + 1)));
+			Node *header = reinterpret_cast<Node *>(slab);
+			header->next = slabs_;
+			slabs_ = header;
+			for (std::size_t i = count; i > 0; --i)
+			{
+				Node *n = reinterpret_cast<Node *>(slab + i * block);
+				n->next = free_[c];
+				free_[c] = n;
+			}
+		}
+	};
+
+	// Аллокатор поверх Arena. Как у std::pmr: аллокатор не распространяется
+	// при присваивании и swap, контейнер остаётся в своей арене.
+	template <typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+		using pointer = T *;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::false_type;
+		using propagate_on_container_swap = std::false_type;
+		using is_always_equal = std::false_type;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = ArenaAllocator<U>;
+		};
+
+		ArenaAllocator(Arena &arena) noexcept : arena_(&arena) {}
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena_(other.arena()) {}
+
+		pointer allocate(size_type n)
+		{
+			if (n > max_size())
+				throw std::bad_alloc();
+			return static_cast<pointer>(arena_->allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(pointer p, size_type n) noexcept
+		{
+			arena_->deallocate(p, n * sizeof(T));
+		}
+
+		bool try_expand(pointer p, size_type old_n, size_type new_n) noexcept
+		{
+			return new_n <= max_size() && arena_->try_expand(p, old_n * sizeof(T), new_n * sizeof(T));
+		}
+
+		size_type max_size() const noexcept
+		{
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		Arena *arena() const noexcept { return arena_; }
+
+		template <typename U>
+		bool operator==(const ArenaAllocator<U> &o) const noexcept { return arena_ == o.arena(); }
+		template <typename U>
+		bool operator!=(const ArenaAllocator<U> &o) const noexcept { return arena_ != o.arena(); }
+
+	private:
+		Arena *arena_;
+	};
+
+	// Аллокатор поверх Pool; семантика распространения та же, что у ArenaAllocator
+	template <typename T>
+	class PoolAllocator
+	{
+	public:
+		using value_type = T;
+		using pointer = T *;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::false_type;
+		using propagate_on_container_swap = std::false_type;
+		using is_always_equal = std::false_type;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = PoolAllocator<U>;
+		};
+
+		PoolAllocator(Pool &pool) noexcept : pool_(&pool) {}
+		template <typename U>
+		PoolAllocator(const PoolAllocator<U> &other) noexcept : pool_(other.pool()) {}
+
+		pointer allocate(size_type n)
+		{
+			if (n > max_size())
+				throw std::bad_alloc();
+			return static_cast<pointer>(pool_->allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(pointer p, size_type n) noexcept
+		{
+			pool_->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		size_type max_size() const noexcept
+		{
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		Pool *pool() const noexcept { return pool_; }
+
+		template <typename U>
+		bool operator==(const PoolAllocator<U> &o) const noexcept { return pool_ == o.pool(); }
+		template <typename U>
+		bool operator!=(const PoolAllocator<U> &o) const noexcept { return pool_ != o.pool(); }
+
+	private:
+		Pool *pool_;
+	};
+
+	// Аллокатор с выравниванием Align (по умолчанию - кэш-линия) для
+	// векторизованных ядер. При HugePages блоки от 2 MiB выделяются через mmap,
+	// выравниваются по 2 MiB и помечаются madvise(MADV_HUGEPAGE).
+	template <typename T, std::size_t Align = 64, bool HugePages = false>
+	class AlignedAllocator
+	{
+		static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+
+	public:
+		using value_type = T;
+		using pointer = T *;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		static constexpr std::size_t alignment = Align > alignof(T) ? Align : alignof(T);
+
+		template <typename U>
+		struct rebind
+		{
+			using other = AlignedAllocator<U, Align, HugePages>;
+		};
+
+		AlignedAllocator() noexcept = default;
+		template <typename U>
+		AlignedAllocator(const AlignedAllocator<U, Align, HugePages> &) noexcept {}
+
+		pointer allocate(size_type n)
+		{
+			if (n > max_size())
+				throw std::bad_alloc();
+#ifdef MIV_HAS_MMAP
+			if (is_huge(n))
+				return static_cast<pointer>(detail::map_huge_pages(n * sizeof(T)));
+#endif
+			return static_cast<pointer>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+		}
+		void deallocate(pointer p, size_type n) noexcept
+		{
+#ifdef MIV_HAS_MMAP
+			if (is_huge(n))
+				return detail::unmap_huge_pages(p, n * sizeof(T));
+#endif
+			::operator delete(p, std::align_val_t(alignment));
+		}
+
+		size_type max_size() const noexcept
+		{
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		template <typename U>
+		bool operator==(const AlignedAllocator<U, Align, HugePages> &) const noexcept { return true; }
+		template <typename U>
+		bool operator!=(const AlignedAllocator<U, Align, HugePages> &) const noexcept { return false; }
+
+	private:
+		static bool is_huge(size_type n) noexcept
+		{
+			return HugePages && alignment <= detail::huge_page_size &&
+				   n >= detail::huge_page_size / sizeof(T);
+		}
+	};
+
+	// Кэш-линия + huge pages для больших сканируемых векторов
+	template <typename T>
+	using HugePageAllocator = AlignedAllocator<T, 64, true>;
+
+	// Аллокатор поверх CapacityPool: освобождённый блок остаётся в пуле
+	// потока, allocate(n) сначала ищет там блок ровно на n элементов.
+	// Vector<T, RecyclingAllocator<T>> сдаёт буфер в пул при каждом росте и
+	// разрушении; с политикой роста блоки одних и тех же размеров, поэтому в
+	// установившемся режиме обращений к Upstream нет. Блок, выделенный в одном
+	// потоке, может освобождаться в другом - он попадёт в пул того потока.
+	template <typename T, typename Upstream = Allocator<T>>
+	class RecyclingAllocator
+	{
+		using upstream_traits = std::allocator_traits<Upstream>;
+
+	public:
+		using value_type = T;
+		using pointer = T *;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using is_always_equal = std::true_type;
+		// Vector::release_to_pool / acquire_from_pool работают с тем же пулом
+		using pool_upstream = Upstream;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = RecyclingAllocator<U, typename upstream_traits::template rebind_alloc<U>>;
+		};
+
+		RecyclingAllocator() noexcept = default;
+		template <typename U, typename B>
+		RecyclingAllocator(const RecyclingAllocator<U, B> &) noexcept {}
+
+		pointer allocate(size_type n)
+		{
+			if (CapacityPool<T, Upstream> *pool = CapacityPool<T, Upstream>::local())
+				if (pointer p = pool->acquire_exact(n))
+					return p;
+			Upstream up;
+			return upstream_traits::allocate(up, n);
+		}
+		void deallocate(pointer p, size_type n) noexcept
+		{
+			CapacityPool<T, Upstream>::recycle(p, n);
+		}
+
+		size_type max_size() const noexcept
+		{
+			return upstream_traits::max_size(Upstream());
+		}
+
+		template <typename U, typename B>
+		bool operator==(const RecyclingAllocator<U, B> &) const noexcept { return true; }
+		template <typename U, typename B>
+		bool operator!=(const RecyclingAllocator<U, B> &) const noexcept { return false; }
+	};
+}
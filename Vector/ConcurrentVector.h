@@ -0,0 +1,341 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include "Vector.h"
+
+namespace miv
+{
+	// ConcurrentVector<T>: lock-free добавление из многих потоков. Элементы
+	// живут в сегментах геометрически растущего размера (8, 8, 16, 32, ...)
+	// и никогда не переносятся, поэтому ссылки и итераторы стабильны.
+	//
+	// push_back / emplace_back / grow_by и operator[] можно вызывать
+	// одновременно; элемент доступен другим потокам после того, как вернулся
+	// добавивший его вызов. size() считает и ещё конструируемые элементы.
+	// Слот занимается только после выделения его сегмента, поэтому bad_alloc
+	// не оставляет пустых слотов. Бросающий конструктор отрабатывает до
+	// занятия слота, если T перемещается без исключений; иначе в занятом слоте
+	// остаётся объект по умолчанию, а если T не конструируется по умолчанию
+	// без исключений - push_back/emplace_back вызывают std::terminate, а
+	// grow_by не компилируется.
+	// clear(), копирование и разрушение - только без конкурентного доступа.
+	// Аллокатор A должен быть потокобезопасным.
+	template <typename T, typename A = Allocator<T>>
+	class ConcurrentVector
+	{
+	public:
+		using value_type = T;
+		using allocator_type = A;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T &;
+		using const_reference = const T &;
+		using pointer = T *;
+		using const_pointer = const T *;
+		using iterator = SegmentIterator<ConcurrentVector, T>;
+		using const_iterator = SegmentIterator<const ConcurrentVector, const T>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using alloc_traits = std::allocator_traits<allocator_type>;
+
+	private:
+		static constexpr size_type first_bits = 3;
+		static constexpr size_type first_size = size_type(1) << first_bits;
+		static constexpr size_type max_segments = std::numeric_limits<size_type>::digits - first_bits + 1;
+
+		allocator_type alloc_;
+		std::atomic<size_type> sz_;
+		std::atomic<pointer> seg_[max_segments];
+
+		static size_type segment_of(size_type i) noexcept
+		{
+			size_type v = i >> first_bits;
+#if defined(__GNUC__) || defined(__clang__)
+			return v ? std::numeric_limits<unsigned long long>::digits - __builtin_clzll(v) : 0;
+#else
+			size_type k = 0;
+			for (; v; v >>= 1)
+				++k;
+			return k;
+#endif
+		}
+		static size_type segment_base(size_type k) noexcept
+		{
+			return k == 0 ? 0 : first_size << (k - 1);
+		}
+		static size_type segment_size(size_type k) noexcept
+		{
+			return k == 0 ? first_size : first_size << (k - 1);
+		}
+
+		// Сегмент k выделяет первый нуждающийся в нём поток; проигравшие CAS
+		// возвращают свой блок
+		pointer ensure_segment(size_type k)
+		{
+			pointer s = seg_[k].load(std::memory_order_acquire);
+			if (s)
+				return s;
+			pointer fresh = alloc_traits::allocate(alloc_, segment_size(k));
+			if (seg_[k].compare_exchange_strong(s, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+				return fresh;
+			alloc_traits::deallocate(alloc_, fresh, segment_size(k));
+			return s;
+		}
+
+		void ensure_range(size_type first, size_type last)
+		{
+			if (first == last)
+				return;
+			for (size_type k = segment_of(first), e = segment_of(last - 1); k <= e; ++k)
+				ensure_segment(k);
+		}
+
+		pointer slot(size_type i) const noexcept
+		{
+			size_type k = segment_of(i);
+			return seg_[k].load(std::memory_order_acquire) + (i - segment_base(k));
+		}
+
+		// Занять n слотов подряд. Сегменты под них выделяются до того, как
+		// слоты станут видны в size(): исключение ничего не занимает
+		size_type claim(size_type n)
+		{
+			size_type first = sz_.load(std::memory_order_relaxed);
+			do
+				ensure_range(first, first + n);
+			while (!sz_.compare_exchange_weak(first, first + n, std::memory_order_acq_rel, std::memory_order_relaxed));
+			return first;
+		}
+
+		// Слоты [from, to) уже заняты и не могут быть освобождены: после
+		// исключения конструктора в них остаются объекты по умолчанию
+		void fill_failed(size_type from, size_type to) noexcept
+		{
+			if constexpr (std::is_nothrow_default_constructible_v<T>)
+			{
+				for (; from < to; ++from)
+					alloc_traits::construct(alloc_, slot(from));
+			}
+			else
+			{
+				std::terminate();
+			}
+		}
+
+		template <typename... Args>
+		size_type append(Args &&...args)
+		{
+			if constexpr (std::is_nothrow_constructible_v<T, Args &&...>)
+			{
+				size_type i = claim(1);
+				alloc_traits::construct(alloc_, slot(i), std::forward<Args>(args)...);
+				return i;
+			}
+			else if constexpr (std::is_nothrow_move_constructible_v<T>)
+			{
+				// бросающий конструктор отрабатывает до занятия слота
+				T tmp(std::forward<Args>(args)...);
+				size_type i = claim(1);
+				alloc_traits::construct(alloc_, slot(i), std::move(tmp));
+				return i;
+			}
+			else
+			{
+				size_type i = claim(1);
+				try
+				{
+					alloc_traits::construct(alloc_, slot(i), std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					fill_failed(i, i + 1);
+					throw;
+				}
+				return i;
+			}
+		}
+
+		void destroy_all() noexcept
+		{
+			size_type n = sz_.load(std::memory_order_relaxed);
+			for (size_type i = 0; i < n; ++i)
+				alloc_traits::destroy(alloc_, slot(i));
+			for (size_type k = 0; k < max_segments; ++k)
+				if (pointer s = seg_[k].load(std::memory_order_relaxed))
+				{
+					alloc_traits::deallocate(alloc_, s, segment_size(k));
+					seg_[k].store(nullptr, std::memory_order_relaxed);
+				}
+			sz_.store(0, std::memory_order_relaxed);
+		}
+
+	public:
+		ConcurrentVector(const allocator_type &alloc = allocator_type()) noexcept
+			: alloc_(alloc), sz_(0)
+		{
+			for (auto &s : seg_)
+				s.store(nullptr, std::memory_order_relaxed);
+		}
+
+		ConcurrentVector(std::initializer_list<T> il,
+						 const allocator_type &alloc = allocator_type())
+			: ConcurrentVector(alloc)
+		{
+			reserve(il.size());
+			for (const T &v : il)
+				push_back(v);
+		}
+
+		ConcurrentVector(const ConcurrentVector &other)
+			: ConcurrentVector(alloc_traits::select_on_container_copy_construction(other.alloc_))
+		{
+			size_type n = other.size();
+			reserve(n);
+			for (size_type i = 0; i < n; ++i)
+				push_back(other[i]);
+		}
+
+		ConcurrentVector(ConcurrentVector &&other) noexcept
+			: alloc_(std::move(other.alloc_)), sz_(other.sz_.load(std::memory_order_relaxed))
+		{
+			for (size_type k = 0; k < max_segments; ++k)
+			{
+				seg_[k].store(other.seg_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+				other.seg_[k].store(nullptr, std::memory_order_relaxed);
+			}
+			other.sz_.store(0, std::memory_order_relaxed);
+		}
+
+		ConcurrentVector &operator=(const ConcurrentVector &) = delete;
+		ConcurrentVector &operator=(ConcurrentVector &&) = delete;
+
+		~ConcurrentVector()
+		{
+			destroy_all();
+		}
+
+		size_type size() const noexcept { return sz_.load(std::memory_order_acquire); }
+		bool empty() const noexcept { return size() == 0; }
+
+		size_type capacity() const noexcept
+		{
+			size_type cap = 0;
+			for (size_type k = 0; k < max_segments; ++k)
+				if (seg_[k].load(std::memory_order_acquire))
+					cap = segment_base(k) + segment_size(k);
+			return cap;
+		}
+
+		// Заранее выделить сегменты под n элементов (можно вызывать конкурентно)
+		void reserve(size_type n)
+		{
+			ensure_range(0, n);
+		}
+
+		iterator push_back(const T &v)
+		{
+			return iterator(this, append(v));
+		}
+		iterator push_back(T &&v)
+		{
+			return iterator(this, append(std::move(v)));
+		}
+
+		template <typename... Args>
+		reference emplace_back(Args &&...args)
+		{
+			return *slot(append(std::forward<Args>(args)...));
+		}
+
+		// Атомарно занять n подряд идущих слотов; возвращает итератор на первый.
+		// Бросающие копии строятся во временном буфере до занятия слотов
+		iterator grow_by(size_type n, const T &value = T())
+		{
+			if constexpr (std::is_nothrow_copy_constructible_v<T>)
+			{
+				size_type first = claim(n);
+				for (size_type i = first; i < first + n; ++i)
+					alloc_traits::construct(alloc_, slot(i), value);
+				return iterator(this, first);
+			}
+			else if constexpr (std::is_nothrow_move_constructible_v<T>)
+			{
+				Vector<T, A> copies(n, value, alloc_);
+				size_type first = claim(n);
+				for (size_type i = 0; i < n; ++i)
+					alloc_traits::construct(alloc_, slot(first + i), std::move(copies[i]));
+				return iterator(this, first);
+			}
+			else
+			{
+				static_assert(std::is_nothrow_default_constructible_v<T>,
+							  "grow_by requires a nothrow copy, move or default constructor");
+				size_type first = claim(n);
+				size_type i = first;
+				try
+				{
+					for (; i < first + n; ++i)
+						alloc_traits::construct(alloc_, slot(i), value);
+				}
+				catch (...)
+				{
+					fill_failed(i, first + n);
+					throw;
+				}
+				return iterator(this, first);
+			}
+		}
+
+		// Не потокобезопасно: сегменты остаются выделенными
+		void clear() noexcept
+		{
+			size_type n = sz_.load(std::memory_order_relaxed);
+			for (size_type i = 0; i < n; ++i)
+				alloc_traits::destroy(alloc_, slot(i));
+			sz_.store(0, std::memory_order_relaxed);
+		}
+
+		// wait-free доступ
+		reference operator[](size_type i) noexcept { return *slot(i); }
+		const_reference operator[](size_type i) const noexcept { return *slot(i); }
+
+		reference at(size_type i)
+		{
+			if (i >= size())
+				throw Range_error(i);
+			return *slot(i);
+		}
+		const_reference at(size_type i) const
+		{
+			if (i >= size())
+				throw Range_error(i);
+			return *slot(i);
+		}
+
+		reference front() noexcept { return *slot(0); }
+		const_reference front() const noexcept { return *slot(0); }
+		reference back() noexcept { return *slot(size() - 1); }
+		const_reference back() const noexcept { return *slot(size() - 1); }
+
+		iterator begin() noexcept { return iterator(this, 0); }
+		const_iterator begin() const noexcept { return const_iterator(this, 0); }
+		iterator end() noexcept { return iterator(this, size()); }
+		const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+		allocator_type get_allocator() const noexcept
+		{
+			return alloc_;
+		}
+
+		size_type max_size() const noexcept
+		{
+			return alloc_traits::max_size(alloc_);
+		}
+	};
+}
@@ -0,0 +1,665 @@
+#pragma once
+
+#include "Vector.h"
+
+namespace miv
+{
+	namespace detail
+	{
+		// Хранилище FixedVector. Для тривиальных T - обычный массив: объект
+		// тривиально копируется и годится для constexpr. C++17 требует
+		// инициализировать в constexpr все члены, поэтому массив обнуляется
+		// при создании.
+		template <typename T, std::size_t N, bool = std::is_trivial_v<T>>
+		struct FixedStorage
+		{
+			T elem_[N ? N : 1] = {};
+			std::size_t sz_ = 0;
+
+			constexpr T *ptr() noexcept { return elem_; }
+			constexpr const T *ptr() const noexcept { return elem_; }
+		};
+
+		// Остальные T - сырые байты и placement new
+		template <typename T, std::size_t N>
+		struct FixedStorage<T, N, false>
+		{
+			alignas(T) unsigned char buf_[(N ? N : 1) * sizeof(T)];
+			std::size_t sz_ = 0;
+
+			FixedStorage() noexcept {}
+
+			FixedStorage(const FixedStorage &other)
+			{
+				init_from(other.ptr(), other.sz_);
+			}
+
+			FixedStorage(FixedStorage &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			{
+				init_from(std::make_move_iterator(other.ptr()), other.sz_);
+			}
+
+			FixedStorage &operator=(const FixedStorage &other)
+			{
+				if (this != &other)
+					assign_from(other.ptr(), other.sz_);
+				return *this;
+			}
+
+			FixedStorage &operator=(FixedStorage &&other) noexcept(
+				std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>)
+			{
+				if (this != &other)
+					assign_from(std::make_move_iterator(other.ptr()), other.sz_);
+				return *this;
+			}
+
+			~FixedStorage()
+			{
+				truncate(0);
+			}
+
+			T *ptr() noexcept { return reinterpret_cast<T *>(buf_); }
+			const T *ptr() const noexcept { return reinterpret_cast<const T *>(buf_); }
+
+			void truncate(std::size_t n) noexcept
+			{
+				for (std::size_t i = n; i < sz_; ++i)
+					ptr()[i].~T();
+				sz_ = n;
+			}
+
+			// Достроить n элементов из src за концом; sz_ растёт поэлементно
+			template <typename It>
+			void append(It src, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i, ++src, ++sz_)
+					::new (static_cast<void *>(ptr() + sz_)) T(*src);
+			}
+
+			template <typename It>
+			void init_from(It src, std::size_t n)
+			{
+				try
+				{
+					append(src, n);
+				}
+				catch (...)
+				{
+					truncate(0);
+					throw;
+				}
+			}
+
+			// Общая часть присваивается, остаток достраивается или уничтожается
+			template <typename It>
+			void assign_from(It src, std::size_t n)
+			{
+				std::size_t common = n < sz_ ? n : sz_;
+				for (std::size_t i = 0; i < common; ++i, ++src)
+					ptr()[i] = *src;
+				if (n < sz_)
+					truncate(n);
+				else
+					append(src, n - common);
+			}
+		};
+	}
+
+	// FixedVector<T, N>: вектор с ёмкостью N прямо в объекте, без аллокатора
+	// и без обращений к куче (как std::inplace_vector). Выход за ёмкость в
+	// push_back/insert/resize - std::bad_alloc; try_push_back/try_emplace_back
+	// вместо этого возвращают nullptr. Для тривиальных T весь интерфейс
+	// constexpr, а сам FixedVector тривиально копируется.
+	template <typename T, std::size_t N>
+	class FixedVector : private detail::FixedStorage<T, N>
+	{
+		using base = detail::FixedStorage<T, N>;
+		static constexpr bool trivial = std::is_trivial_v<T>;
+		static constexpr bool nothrow_shift = is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T &;
+		using const_reference = const T &;
+		using pointer = T *;
+		using const_pointer = const T *;
+		using iterator = VectorIterator<T>;
+		using const_iterator = VectorIterator<const T>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		FixedVector() = default;
+
+		constexpr explicit FixedVector(size_type n, const T &value = T())
+		{
+			assign(n, value);
+		}
+
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		constexpr FixedVector(InputIt first, InputIt last)
+		{
+			assign(first, last);
+		}
+
+		constexpr FixedVector(std::initializer_list<T> il)
+			: FixedVector(il.begin(), il.end())
+		{
+		}
+
+		constexpr FixedVector &operator=(std::initializer_list<T> il)
+		{
+			assign(il.begin(), il.end());
+			return *this;
+		}
+
+		// Размер и ёмкость
+		constexpr bool empty() const noexcept { return this->sz_ == 0; }
+		constexpr bool full() const noexcept { return this->sz_ == N; }
+		constexpr size_type size() const noexcept { return this->sz_; }
+		static constexpr size_type capacity() noexcept { return N; }
+		static constexpr size_type max_size() noexcept { return N; }
+
+		// Ёмкость не растёт: reserve только проверяет, что n помещается
+		static constexpr void reserve(size_type n)
+		{
+			if (n > N)
+				throw std::bad_alloc();
+		}
+		static constexpr void shrink_to_fit() noexcept {}
+
+		// Модификаторы
+		constexpr void clear() noexcept
+		{
+			truncate(0);
+		}
+
+		constexpr void resize(size_type count, const T &value = T())
+		{
+			if (count <= this->sz_)
+				return truncate(count);
+			reserve(count);
+			T tmp(value);
+			while (this->sz_ < count)
+				construct_back(tmp);
+		}
+
+		constexpr void push_back(const T &v)
+		{
+			emplace_back(v);
+		}
+		constexpr void push_back(T &&v)
+		{
+			emplace_back(std::move(v));
+		}
+
+		template <typename... Args>
+		constexpr reference emplace_back(Args &&...args)
+		{
+			if (full())
+				throw std::bad_alloc();
+			return construct_back(std::forward<Args>(args)...);
+		}
+
+		// Без исключения при нехватке места: указатель на новый элемент
+		// или nullptr, если вектор полон
+		constexpr pointer try_push_back(const T &v)
+		{
+			return try_emplace_back(v);
+		}
+		constexpr pointer try_push_back(T &&v)
+		{
+			return try_emplace_back(std::move(v));
+		}
+
+		template <typename... Args>
+		constexpr pointer try_emplace_back(Args &&...args)
+		{
+			if (full())
+				return nullptr;
+			return &construct_back(std::forward<Args>(args)...);
+		}
+
+		constexpr void pop_back() noexcept
+		{
+			if (this->sz_ > 0)
+				truncate(this->sz_ - 1);
+		}
+
+		// assign
+		constexpr void assign(size_type count, const T &value)
+		{
+			reserve(count);
+			T tmp(value);
+			size_type common = count < this->sz_ ? count : this->sz_;
+			for (size_type i = 0; i < common; ++i)
+				this->ptr()[i] = tmp;
+			truncate(common);
+			while (this->sz_ < count)
+				construct_back(tmp);
+		}
+
+		template <typename InputIt,
+				  typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		constexpr void assign(InputIt first, InputIt last)
+		{
+			if constexpr (detail::is_forward_iterator_v<InputIt>)
+				reserve(static_cast<size_type>(std::distance(first, last)));
+			clear();
+			for (; first != last; ++first)
+				emplace_back(*first);
+		}
+
+		constexpr void assign(std::initializer_list<T> il)
+		{
+			assign(il.begin(), il.end());
+		}
+
+		// insert - emplace - erase
+		constexpr iterator insert(const_iterator pos, const T &value)
+		{
+			return emplace(pos, value);
+		}
+
+		constexpr iterator insert(const_iterator pos, T &&value)
+		{
+			return emplace(pos, std::move(value));
+		}
+
+		constexpr iterator insert(const_iterator pos, size_type count, const T &value)
+		{
+			size_type idx = pos - begin();
+			if (count == 0)
+				return begin() + idx;
+			reserve(this->sz_ + count);
+			T tmp(value);
+			if constexpr (trivial)
+			{
+				open_gap(idx, count);
+				for (size_type i = 0; i < count; ++i)
+					this->ptr()[idx + i] = tmp;
+			}
+			else
+				insert_fill(idx, count, tmp);
+			return begin() + idx;
+		}
+
+		template <typename InputIt,
+				  typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		constexpr iterator insert(const_iterator pos, InputIt first, InputIt last)
+		{
+			size_type idx = pos - begin();
+			if constexpr (!detail::is_forward_iterator_v<InputIt>)
+			{
+				// однопроходный диапазон: дописать в конец и повернуть
+				size_type old = this->sz_;
+				for (; first != last; ++first)
+					emplace_back(*first);
+				rotate(idx, old);
+			}
+			else
+			{
+				size_type count = static_cast<size_type>(std::distance(first, last));
+				if (count == 0)
+					return begin() + idx;
+				reserve(this->sz_ + count);
+				if constexpr (trivial)
+				{
+					open_gap(idx, count);
+					for (size_type i = 0; i < count; ++i, ++first)
+						this->ptr()[idx + i] = *first;
+				}
+				else
+					insert_range(idx, count, first, last);
+			}
+			return begin() + idx;
+		}
+
+		constexpr iterator insert(const_iterator pos, std::initializer_list<T> il)
+		{
+			return insert(pos, il.begin(), il.end());
+		}
+
+		template <typename... Args>
+		constexpr iterator emplace(const_iterator pos, Args &&...args)
+		{
+			size_type idx = pos - begin();
+			if (full())
+				throw std::bad_alloc();
+			if (idx == this->sz_)
+				construct_back(std::forward<Args>(args)...);
+			else
+			{
+				// элемент строится до сдвига: args могут ссылаться на хвост
+				T tmp(std::forward<Args>(args)...);
+				if constexpr (trivial)
+				{
+					open_gap(idx, 1);
+					this->ptr()[idx] = tmp;
+				}
+				else
+					insert_range(idx, 1, std::make_move_iterator(&tmp), std::make_move_iterator(&tmp + 1));
+			}
+			return begin() + idx;
+		}
+
+		constexpr iterator erase(const_iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+		constexpr iterator erase(const_iterator first, const_iterator last)
+		{
+			size_type idx = first - begin();
+			size_type count = last - first;
+			if (count == 0)
+				return begin() + idx;
+			if constexpr (trivial)
+			{
+				for (size_type i = idx + count; i < this->sz_; ++i)
+					this->ptr()[i - count] = this->ptr()[i];
+				this->sz_ -= count;
+			}
+			else if constexpr (nothrow_shift)
+			{
+				std::allocator<T> alloc;
+				for (size_type i = idx; i < idx + count; ++i)
+					this->ptr()[i].~T();
+				detail::shift_left(alloc, this->ptr(), this->sz_, idx + count, count);
+				this->sz_ -= count;
+			}
+			else
+			{
+				std::move(this->ptr() + idx + count, this->ptr() + this->sz_, this->ptr() + idx);
+				truncate(this->sz_ - count);
+			}
+			return begin() + idx;
+		}
+
+		// Как Vector::remove_if: один проход, возвращает число удалённых
+		template <typename Pred>
+		constexpr size_type remove_if(Pred pred)
+		{
+			pointer p = this->ptr();
+			size_type out = 0;
+			for (size_type i = 0; i < this->sz_; ++i)
+			{
+				if (!pred(static_cast<const T &>(p[i])))
+				{
+					if (out != i)
+						p[out] = std::move(p[i]);
+					++out;
+				}
+			}
+			size_type removed = this->sz_ - out;
+			truncate(out);
+			return removed;
+		}
+
+		constexpr iterator erase_unordered(const_iterator pos)
+		{
+			size_type idx = pos - begin();
+			if (idx + 1 != this->sz_)
+				this->ptr()[idx] = std::move(this->ptr()[this->sz_ - 1]);
+			truncate(this->sz_ - 1);
+			return begin() + idx;
+		}
+
+		// Элементы общей части меняются местами, остаток переносится
+		constexpr void swap(FixedVector &other) noexcept(std::is_nothrow_swappable_v<T> &&
+														 std::is_nothrow_move_constructible_v<T>)
+		{
+			FixedVector *shorter = this->sz_ < other.sz_ ? this : &other;
+			FixedVector *longer = shorter == this ? &other : this;
+			size_type common = shorter->sz_;
+			for (size_type i = 0; i < common; ++i)
+			{
+				T tmp(std::move(this->ptr()[i]));
+				this->ptr()[i] = std::move(other.ptr()[i]);
+				other.ptr()[i] = std::move(tmp);
+			}
+			for (size_type i = common; i < longer->sz_; ++i)
+				shorter->construct_back(std::move(longer->ptr()[i]));
+			longer->truncate(common);
+		}
+
+		constexpr reference operator[](size_type i) noexcept { return this->ptr()[i]; }
+		constexpr const_reference operator[](size_type i) const noexcept { return this->ptr()[i]; }
+
+		constexpr reference at(size_type i)
+		{
+			if (i >= this->sz_)
+				throw Range_error(i);
+			return this->ptr()[i];
+		}
+		constexpr const_reference at(size_type i) const
+		{
+			if (i >= this->sz_)
+				throw Range_error(i);
+			return this->ptr()[i];
+		}
+
+		constexpr reference front() noexcept { return this->ptr()[0]; }
+		constexpr const_reference front() const noexcept { return this->ptr()[0]; }
+		constexpr reference back() noexcept { return this->ptr()[this->sz_ - 1]; }
+		constexpr const_reference back() const noexcept { return this->ptr()[this->sz_ - 1]; }
+
+		constexpr pointer data() noexcept { return this->ptr(); }
+		constexpr const_pointer data() const noexcept { return this->ptr(); }
+
+		constexpr iterator begin() noexcept { return iterator(this->ptr()); }
+		constexpr const_iterator begin() const noexcept { return const_iterator(this->ptr()); }
+		constexpr const_iterator cbegin() const noexcept { return begin(); }
+		constexpr iterator end() noexcept { return iterator(this->ptr() + this->sz_); }
+		constexpr const_iterator end() const noexcept { return const_iterator(this->ptr() + this->sz_); }
+		constexpr const_iterator cend() const noexcept { return end(); }
+
+		constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+		constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+	private:
+		// Построить элемент за концом; ёмкость уже проверена
+		template <typename... Args>
+		constexpr reference construct_back(Args &&...args)
+		{
+			pointer p = this->ptr() + this->sz_;
+			if constexpr (trivial)
+				*p = T(std::forward<Args>(args)...);
+			else
+				::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+			++this->sz_;
+			return *p;
+		}
+
+		constexpr void truncate(size_type n) noexcept
+		{
+			if constexpr (trivial)
+				this->sz_ = n;
+			else
+				base::truncate(n);
+		}
+
+		// Тривиальные T: сдвиг хвоста присваиванием, в constexpr без memmove
+		constexpr void open_gap(size_type idx, size_type count) noexcept
+		{
+			for (size_type i = this->sz_; i-- > idx;)
+				this->ptr()[i + count] = this->ptr()[i];
+			this->sz_ += count;
+		}
+
+		// [idx, old) и [old, size()) меняются местами
+		constexpr void rotate(size_type idx, size_type old)
+		{
+			pointer p = this->ptr();
+			size_type first = idx, middle = old, next = old, last = this->sz_;
+			if (first == middle || middle == last)
+				return;
+			while (first != next)
+			{
+				T tmp(std::move(p[first]));
+				p[first++] = std::move(p[next]);
+				p[next++] = std::move(tmp);
+				if (next == last)
+					next = middle;
+				else if (first == middle)
+					middle = next;
+			}
+		}
+
+		// Нетривиальные T: как в Vector - перенос хвоста, если он не бросает,
+		// иначе move-присваивание по живым элементам
+		void insert_fill(size_type idx, size_type count, const T &tmp)
+		{
+			pointer p = this->ptr();
+			if constexpr (nothrow_shift)
+			{
+				std::allocator<T> alloc;
+				detail::shift_right(alloc, p, this->sz_, idx, count);
+				size_type i = 0;
+				try
+				{
+					for (; i < count; ++i)
+						::new (static_cast<void *>(p + idx + i)) T(tmp);
+				}
+				catch (...)
+				{
+					detail::unshift_right(alloc, p, this->sz_, idx, count, i);
+					throw;
+				}
+				this->sz_ += count;
+			}
+			else
+			{
+				size_type old = this->sz_;
+				if (old - idx > count)
+				{
+					for (size_type i = old - count; i < old; ++i)
+						construct_back(std::move(p[i]));
+					std::move_backward(p + idx, p + old - count, p + old);
+					for (size_type i = 0; i < count; ++i)
+						p[idx + i] = tmp;
+				}
+				else
+				{
+					for (size_type k = old - idx; k < count; ++k)
+						construct_back(tmp);
+					for (size_type i = idx; i < old; ++i)
+						construct_back(std::move(p[i]));
+					for (size_type i = idx; i < old; ++i)
+						p[i] = tmp;
+				}
+			}
+		}
+
+		template <typename It>
+		void insert_range(size_type idx, size_type count, It first, It last)
+		{
+			pointer p = this->ptr();
+			if constexpr (nothrow_shift)
+			{
+				std::allocator<T> alloc;
+				detail::shift_right(alloc, p, this->sz_, idx, count);
+				size_type i = 0;
+				try
+				{
+					for (; first != last; ++first, ++i)
+						::new (static_cast<void *>(p + idx + i)) T(*first);
+				}
+				catch (...)
+				{
+					detail::unshift_right(alloc, p, this->sz_, idx, count, i);
+					throw;
+				}
+				this->sz_ += count;
+			}
+			else
+			{
+				size_type old = this->sz_;
+				if (old - idx > count)
+				{
+					for (size_type i = old - count; i < old; ++i)
+						construct_back(std::move(p[i]));
+					std::move_backward(p + idx, p + old - count, p + old);
+					std::copy(first, last, p + idx);
+				}
+				else
+				{
+					It mid = std::next(first, static_cast<difference_type>(old - idx));
+					for (It it = mid; it != last; ++it)
+						construct_back(*it);
+					for (size_type i = idx; i < old; ++i)
+						construct_back(std::move(p[i]));
+					std::copy(first, mid, p + idx);
+				}
+			}
+		}
+	};
+
+	template <typename T, std::size_t N>
+	constexpr void swap(FixedVector<T, N> &x, FixedVector<T, N> &y) noexcept(noexcept(x.swap(y)))
+	{
+		x.swap(y);
+	}
+
+	template <typename T, std::size_t N, typename Pred>
+	constexpr std::size_t erase_if(FixedVector<T, N> &v, Pred pred)
+	{
+		return v.remove_if(std::move(pred));
+	}
+	template <typename T, std::size_t N, typename U>
+	constexpr std::size_t erase(FixedVector<T, N> &v, const U &value)
+	{
+		return v.remove_if([&value](const T &x) { return x == value; });
+	}
+
+	// Сравнения циклами: std::equal/lexicographical_compare constexpr только с C++20
+	template <typename T, std::size_t N>
+	constexpr bool operator==(const FixedVector<T, N> &x, const FixedVector<T, N> &y)
+	{
+		if (x.size() != y.size())
+			return false;
+		for (std::size_t i = 0; i < x.size(); ++i)
+			if (!(x[i] == y[i]))
+				return false;
+		return true;
+	}
+	template <typename T, std::size_t N>
+	constexpr bool operator!=(const FixedVector<T, N> &x, const FixedVector<T, N> &y)
+	{
+		return !(x == y);
+	}
+	template <typename T, std::size_t N>
+	constexpr bool operator<(const FixedVector<T, N> &x, const FixedVector<T, N> &y)
+	{
+		std::size_t n = x.size() < y.size() ? x.size() : y.size();
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			if (x[i] < y[i])
+				return true;
+			if (y[i] < x[i])
+				return false;
+		}
+		return x.size() < y.size();
+	}
+	template <typename T, std::size_t N>
+	constexpr bool operator>(const FixedVector<T, N> &x, const FixedVector<T, N> &y)
+	{
+		return y < x;
+	}
+	template <typename T, std::size_t N>
+	constexpr bool operator<=(const FixedVector<T, N> &x, const FixedVector<T, N> &y)
+	{
+		return !(y < x);
+	}
+	template <typename T, std::size_t N>
+	constexpr bool operator>=(const FixedVector<T, N> &x, const FixedVector<T, N> &y)
+	{
+		return !(x < y);
+	}
+}
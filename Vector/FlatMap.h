@@ -0,0 +1,472 @@
+#pragma once
+
+#include "FlatSet.h"
+#include <stdexcept>
+
+namespace miv
+{
+	// Итератор FlatMap: пара указателей в колонки ключей и значений.
+	// Разыменование даёт std::pair<const K &, V &> по значению
+	template <typename K, typename V>
+	class FlatMapIterator
+	{
+	private:
+		template <typename, typename>
+		friend class FlatMapIterator;
+		const K *k_;
+		V *v_;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::pair<K, std::remove_const_t<V>>;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::pair<const K &, V &>;
+
+		// it->second: ссылка-пара живёт во временном объекте
+		struct pointer
+		{
+			reference ref;
+			const reference *operator->() const noexcept { return &ref; }
+		};
+
+		FlatMapIterator() noexcept : k_(nullptr), v_(nullptr) {}
+		FlatMapIterator(const K *k, V *v) noexcept : k_(k), v_(v) {}
+
+		template <typename U, typename = std::enable_if_t<std::is_convertible_v<U *, V *>>>
+		FlatMapIterator(const FlatMapIterator<K, U> &other) noexcept : k_(other.k_), v_(other.v_)
+		{
+		}
+
+		reference operator*() const noexcept { return reference(*k_, *v_); }
+		pointer operator->() const noexcept { return pointer{ **this }; }
+		reference operator[](difference_type n) const noexcept { return reference(k_[n], v_[n]); }
+
+		const K &key() const noexcept { return *k_; }
+		V &value() const noexcept { return *v_; }
+
+		FlatMapIterator &operator++() noexcept
+		{
+			++k_;
+			++v_;
+			return *this;
+		}
+		FlatMapIterator operator++(int) noexcept
+		{
+			FlatMapIterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+		FlatMapIterator &operator--() noexcept
+		{
+			--k_;
+			--v_;
+			return *this;
+		}
+		FlatMapIterator operator--(int) noexcept
+		{
+			FlatMapIterator tmp(*this);
+			--*this;
+			return tmp;
+		}
+		FlatMapIterator &operator+=(difference_type n) noexcept
+		{
+			k_ += n;
+			v_ += n;
+			return *this;
+		}
+		FlatMapIterator &operator-=(difference_type n) noexcept
+		{
+			k_ -= n;
+			v_ -= n;
+			return *this;
+		}
+
+		FlatMapIterator operator+(difference_type n) const noexcept { return FlatMapIterator(k_ + n, v_ + n); }
+		friend FlatMapIterator operator+(difference_type n, const FlatMapIterator &it) noexcept { return it + n; }
+		FlatMapIterator operator-(difference_type n) const noexcept { return FlatMapIterator(k_ - n, v_ - n); }
+		difference_type operator-(const FlatMapIterator &o) const noexcept { return k_ - o.k_; }
+
+		bool operator==(const FlatMapIterator &o) const noexcept { return k_ == o.k_; }
+		bool operator!=(const FlatMapIterator &o) const noexcept { return k_ != o.k_; }
+		bool operator<(const FlatMapIterator &o) const noexcept { return k_ < o.k_; }
+		bool operator>(const FlatMapIterator &o) const noexcept { return k_ > o.k_; }
+		bool operator<=(const FlatMapIterator &o) const noexcept { return k_ <= o.k_; }
+		bool operator>=(const FlatMapIterator &o) const noexcept { return k_ >= o.k_; }
+	};
+
+	// FlatMap<K, V>: отсортированные ключи и значения в двух Vector одной
+	// длины. Поиск читает только плотный массив ключей, значения трогаются
+	// лишь у найденного. Вставка и поиск - как у FlatSet; при исключении
+	// посреди изменения колонки возвращаются к согласованному состоянию.
+	template <typename K, typename V, typename C = std::less<K>, typename Search = BranchlessSearch>
+	class FlatMap
+	{
+	public:
+		using key_type = K;
+		using mapped_type = V;
+		using value_type = std::pair<K, V>;
+		using key_compare = C;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using iterator = FlatMapIterator<K, V>;
+		using const_iterator = FlatMapIterator<K, const V>;
+		using reference = typename iterator::reference;
+		using const_reference = typename const_iterator::reference;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using key_container_type = Vector<K>;
+		using mapped_container_type = Vector<V>;
+
+		FlatMap() = default;
+
+		explicit FlatMap(const C &comp) : comp_(comp) {}
+
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		FlatMap(InputIt first, InputIt last, const C &comp = C()) : comp_(comp)
+		{
+			insert(first, last);
+		}
+
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		FlatMap(sorted_unique_t, InputIt first, InputIt last, const C &comp = C()) : comp_(comp)
+		{
+			insert(sorted_unique, first, last);
+		}
+
+		FlatMap(std::initializer_list<value_type> il, const C &comp = C()) : FlatMap(il.begin(), il.end(), comp) {}
+
+		FlatMap &operator=(std::initializer_list<value_type> il)
+		{
+			FlatMap tmp(il, comp_);
+			swap(tmp);
+			return *this;
+		}
+
+		bool empty() const noexcept { return keys_.empty(); }
+		size_type size() const noexcept { return keys_.size(); }
+		size_type max_size() const noexcept { return std::min(keys_.max_size(), values_.max_size()); }
+
+		void reserve(size_type n)
+		{
+			keys_.reserve(n);
+			values_.reserve(n);
+		}
+
+		void shrink_to_fit()
+		{
+			keys_.shrink_to_fit();
+			values_.shrink_to_fit();
+		}
+
+		void clear() noexcept
+		{
+			keys_.clear();
+			values_.clear();
+			reindex();
+		}
+
+		V &operator[](const K &key) { return try_emplace(key).first.value(); }
+		V &operator[](K &&key) { return try_emplace(std::move(key)).first.value(); }
+
+		V &at(const K &key)
+		{
+			size_type i = find_index(key);
+			if (i == size())
+				throw std::out_of_range("FlatMap::at: key not found");
+			return values_[i];
+		}
+		const V &at(const K &key) const
+		{
+			size_type i = find_index(key);
+			if (i == size())
+				throw std::out_of_range("FlatMap::at: key not found");
+			return values_[i];
+		}
+
+		// Значение строится только если ключа ещё нет
+		template <typename... Args>
+		std::pair<iterator, bool> try_emplace(const K &key, Args &&...args)
+		{
+			return emplace_key(key, std::forward<Args>(args)...);
+		}
+		template <typename... Args>
+		std::pair<iterator, bool> try_emplace(K &&key, Args &&...args)
+		{
+			return emplace_key(std::move(key), std::forward<Args>(args)...);
+		}
+
+		template <typename M>
+		std::pair<iterator, bool> insert_or_assign(const K &key, M &&obj)
+		{
+			auto r = try_emplace(key, std::forward<M>(obj));
+			if (!r.second)
+				r.first.value() = std::forward<M>(obj);
+			return r;
+		}
+		template <typename M>
+		std::pair<iterator, bool> insert_or_assign(K &&key, M &&obj)
+		{
+			auto r = try_emplace(std::move(key), std::forward<M>(obj));
+			if (!r.second)
+				r.first.value() = std::forward<M>(obj);
+			return r;
+		}
+
+		std::pair<iterator, bool> insert(const value_type &kv) { return emplace_key(kv.first, kv.second); }
+		std::pair<iterator, bool> insert(value_type &&kv) { return emplace_key(std::move(kv.first), std::move(kv.second)); }
+
+		template <typename... Args>
+		std::pair<iterator, bool> emplace(Args &&...args)
+		{
+			return insert(value_type(std::forward<Args>(args)...));
+		}
+
+		// Пачка, как FlatSet::insert(first, last): хвост пар сортируется
+		// устойчиво, из повторов остаётся первый, существующие ключи не
+		// перезаписываются; затем одно слияние обеих колонок
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		void insert(InputIt first, InputIt last)
+		{
+			Vector<value_type> tail(first, last);
+			auto by_key = [this](const value_type &a, const value_type &b) { return comp_(a.first, b.first); };
+			std::stable_sort(tail.begin(), tail.end(), by_key);
+			tail.erase(std::unique(tail.begin(), tail.end(),
+								   [this](const value_type &a, const value_type &b) { return !comp_(a.first, b.first); }),
+					   tail.end());
+			merge(tail);
+		}
+
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		void insert(sorted_unique_t, InputIt first, InputIt last)
+		{
+			Vector<value_type> tail(first, last);
+			merge(tail);
+		}
+
+		void insert(std::initializer_list<value_type> il) { insert(il.begin(), il.end()); }
+
+		iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			size_type i = static_cast<size_type>(first - cbegin());
+			size_type j = static_cast<size_type>(last - cbegin());
+			values_.erase(values_.begin() + i, values_.begin() + j);
+			keys_.erase(keys_.begin() + i, keys_.begin() + j);
+			reindex();
+			return begin() + i;
+		}
+
+		size_type erase(const K &key)
+		{
+			size_type i = find_index(key);
+			if (i == size())
+				return 0;
+			erase(cbegin() + i);
+			return 1;
+		}
+
+		// Удалить пары, для которых pred(const_reference) истинно, за один
+		// проход по обеим колонкам; индекс перестраивается один раз
+		template <typename Pred>
+		size_type remove_if(Pred pred)
+		{
+			size_type n = size(), out = 0;
+			for (size_type i = 0; i < n; ++i)
+			{
+				if (pred(const_reference(keys_[i], values_[i])))
+					continue;
+				if (out != i)
+				{
+					keys_[out] = std::move(keys_[i]);
+					values_[out] = std::move(values_[i]);
+				}
+				++out;
+			}
+			if (out == n)
+				return 0;
+			values_.erase(values_.begin() + out, values_.end());
+			keys_.erase(keys_.begin() + out, keys_.end());
+			reindex();
+			return n - out;
+		}
+
+		iterator find(const K &key) { return begin() + find_index(key); }
+		const_iterator find(const K &key) const { return cbegin() + find_index(key); }
+
+		bool contains(const K &key) const { return find_index(key) != size(); }
+		size_type count(const K &key) const { return contains(key) ? 1 : 0; }
+
+		iterator lower_bound(const K &key) { return begin() + lower_index(key); }
+		const_iterator lower_bound(const K &key) const { return cbegin() + lower_index(key); }
+		iterator upper_bound(const K &key) { return begin() + upper_index(key); }
+		const_iterator upper_bound(const K &key) const { return cbegin() + upper_index(key); }
+
+		std::pair<iterator, iterator> equal_range(const K &key)
+		{
+			size_type i = lower_index(key);
+			size_type j = i + (i < size() && !comp_(key, keys_[i]) ? 1 : 0);
+			return { begin() + i, begin() + j };
+		}
+		std::pair<const_iterator, const_iterator> equal_range(const K &key) const
+		{
+			size_type i = lower_index(key);
+			size_type j = i + (i < size() && !comp_(key, keys_[i]) ? 1 : 0);
+			return { cbegin() + i, cbegin() + j };
+		}
+
+		key_compare key_comp() const { return comp_; }
+
+		// Колонки целиком: ключи отсортированы, values()[i] относится к keys()[i]
+		const key_container_type &keys() const noexcept { return keys_; }
+		const mapped_container_type &values() const noexcept { return values_; }
+
+		iterator begin() noexcept { return iterator(keys_.data(), values_.data()); }
+		const_iterator begin() const noexcept { return cbegin(); }
+		const_iterator cbegin() const noexcept { return const_iterator(keys_.data(), values_.data()); }
+		iterator end() noexcept { return begin() + size(); }
+		const_iterator end() const noexcept { return cend(); }
+		const_iterator cend() const noexcept { return cbegin() + size(); }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+		void swap(FlatMap &other) noexcept
+		{
+			using std::swap;
+			keys_.swap(other.keys_);
+			values_.swap(other.values_);
+			swap(comp_, other.comp_);
+			swap(index_, other.index_);
+		}
+
+		friend bool operator==(const FlatMap &x, const FlatMap &y)
+		{
+			return x.keys_ == y.keys_ && x.values_ == y.values_;
+		}
+		friend bool operator!=(const FlatMap &x, const FlatMap &y) { return !(x == y); }
+
+	private:
+		key_container_type keys_;
+		mapped_container_type values_;
+		C comp_;
+		typename Search::template index<K> index_;
+
+		size_type lower_index(const K &key) const
+		{
+			return index_.partition_point(keys_.data(), keys_.size(),
+										  [&](const K &x) { return comp_(x, key); });
+		}
+
+		size_type upper_index(const K &key) const
+		{
+			return index_.partition_point(keys_.data(), keys_.size(),
+										  [&](const K &x) { return !comp_(key, x); });
+		}
+
+		// Позиция ключа или size()
+		size_type find_index(const K &key) const { return index_.find(keys_.data(), keys_.size(), key, comp_); }
+
+		void reindex() noexcept { index_.rebuild(keys_.data(), keys_.size()); }
+
+		// Сначала значение, потом ключ: если ключ не встал, значение убирается
+		template <typename Key, typename... Args>
+		std::pair<iterator, bool> emplace_key(Key &&key, Args &&...args)
+		{
+			size_type i = lower_index(key);
+			if (i < size() && !comp_(key, keys_[i]))
+				return { begin() + i, false };
+			values_.emplace(values_.begin() + i, std::forward<Args>(args)...);
+			try
+			{
+				keys_.insert(keys_.begin() + i, std::forward<Key>(key));
+			}
+			catch (...)
+			{
+				values_.erase(values_.begin() + i);
+				throw;
+			}
+			reindex();
+			return { begin() + i, true };
+		}
+
+		// Слияние отсортированного хвоста пар без повторов, как в FlatSet.
+		// При исключении в дописывании колонки обрезаются до прежней длины
+		void merge(Vector<value_type> &tail)
+		{
+			if (tail.empty())
+				return;
+			size_type n = size();
+			if (n == 0 || comp_(keys_.back(), tail.front().first))
+			{
+				reserve(n + tail.size());
+				try
+				{
+					for (value_type &kv : tail)
+					{
+						keys_.push_back(std::move_if_noexcept(kv.first));
+						values_.push_back(std::move_if_noexcept(kv.second));
+					}
+				}
+				catch (...)
+				{
+					keys_.erase(keys_.begin() + n, keys_.end());
+					values_.erase(values_.begin() + std::min(n, values_.size()), values_.end());
+					throw;
+				}
+				reindex();
+				return;
+			}
+			key_container_type ok;
+			mapped_container_type ov;
+			ok.reserve(n + tail.size());
+			ov.reserve(n + tail.size());
+			size_type a = 0;
+			auto b = tail.begin(), be = tail.end();
+			while (a != n && b != be)
+			{
+				if (comp_(b->first, keys_[a]))
+				{
+					ok.push_back(std::move_if_noexcept(b->first));
+					ov.push_back(std::move_if_noexcept(b->second));
+					++b;
+				}
+				else
+				{
+					if (!comp_(keys_[a], b->first))
+						++b;
+					ok.push_back(std::move_if_noexcept(keys_[a]));
+					ov.push_back(std::move_if_noexcept(values_[a]));
+					++a;
+				}
+			}
+			for (; a != n; ++a)
+			{
+				ok.push_back(std::move_if_noexcept(keys_[a]));
+				ov.push_back(std::move_if_noexcept(values_[a]));
+			}
+			for (; b != be; ++b)
+			{
+				ok.push_back(std::move_if_noexcept(b->first));
+				ov.push_back(std::move_if_noexcept(b->second));
+			}
+			keys_.swap(ok);
+			values_.swap(ov);
+			reindex();
+		}
+	};
+
+	template <typename K, typename V, typename C, typename S>
+	void swap(FlatMap<K, V, C, S> &a, FlatMap<K, V, C, S> &b) noexcept
+	{
+		a.swap(b);
+	}
+
+	template <typename K, typename V, typename C, typename S, typename Pred>
+	typename FlatMap<K, V, C, S>::size_type erase_if(FlatMap<K, V, C, S> &m, Pred pred)
+	{
+		return m.remove_if(pred);
+	}
+}
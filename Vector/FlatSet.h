@@ -0,0 +1,494 @@
+#pragma once
+
+#include "Allocators.h"
+#include <algorithm>
+#include <functional>
+
+namespace miv
+{
+	// Метка для вставки уже отсортированного диапазона без повторов:
+	// сортировка и удаление дублей в хвосте пропускаются
+	struct sorted_unique_t
+	{
+		explicit sorted_unique_t() = default;
+	};
+	inline constexpr sorted_unique_t sorted_unique{};
+
+	namespace detail
+	{
+		inline void prefetch(const void *p) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(p);
+#else
+			(void)p;
+#endif
+		}
+
+		// Первая позиция в [a, a + n), где pred ложно (pred - префикс массива).
+		// Без ветвлений в цикле: сравнение выбирает указатель через cmov,
+		// число итераций зависит только от n
+		template <typename T, typename P>
+		std::size_t branchless_partition_point(const T *a, std::size_t n, P pred)
+		{
+			if (n == 0)
+				return 0;
+			const T *base = a;
+			// Массив больше L1: оба возможных следующих пробника загружаются
+			// заранее. Маленьким наборам это только мешает
+			if (n * sizeof(T) > (std::size_t(32) << 10))
+			{
+				while (n > 1)
+				{
+					std::size_t half = n / 2;
+					prefetch(base + half / 2);
+					prefetch(base + half + half / 2);
+					base = pred(base[half]) ? base + half : base;
+					n -= half;
+				}
+			}
+			else
+			{
+				while (n > 1)
+				{
+					std::size_t half = n / 2;
+					base = pred(base[half]) ? base + half : base;
+					n -= half;
+				}
+			}
+			return static_cast<std::size_t>(base - a) + (pred(*base) ? 1 : 0);
+		}
+	}
+
+	// Политики поиска для FlatSet/FlatMap. index<K> строится по отсортированным
+	// ключам после каждого изменения и отвечает на partition_point и find
+	// (позиция ключа или n).
+
+	// Двоичный поиск без ветвлений прямо по отсортированному массиву
+	struct BranchlessSearch
+	{
+		template <typename K>
+		struct index
+		{
+			void rebuild(const K *, std::size_t) noexcept {}
+
+			template <typename P>
+			std::size_t partition_point(const K *a, std::size_t n, P pred) const
+			{
+				return detail::branchless_partition_point(a, n, pred);
+			}
+
+			template <typename C>
+			std::size_t find(const K *a, std::size_t n, const K &key, const C &comp) const
+			{
+				std::size_t i = partition_point(a, n, [&](const K &x) { return comp(x, key); });
+				return i < n && !comp(key, a[i]) ? i : n;
+			}
+		};
+	};
+
+	// Копия ключей в порядке Эйтцингера (BFS-обход дерева поиска): первые
+	// уровни лежат в одной-двух кэш-линиях, а все потомки узла на несколько
+	// уровней вниз занимают одну кэш-линию и подгружаются заранее. Быстрее на
+	// наборах больше L2; цена - копия ключей, индекс позиций и перестройка за
+	// O(n) после каждого изменения (без новых выделений, если набор не
+	// вырос), поэтому вставлять и удалять лучше пачками
+	struct EytzingerSearch
+	{
+		template <typename K>
+		class index
+		{
+		public:
+			// Буферы tree_ и rank_ переиспользуются. Не удалось построить
+			// (исключение при копировании ключа или выделении) - индекс пуст
+			// и поиск идёт по отсортированному массиву
+			void rebuild(const K *a, std::size_t n) noexcept
+			{
+				try
+				{
+					if (n == 0)
+					{
+						tree_.clear();
+						rank_.clear();
+						return;
+					}
+					// Рост вдвое: иначе при вставке по одному ключу каждая
+					// перестройка перевыделяла бы оба буфера
+					if (rank_.capacity() < n + 1)
+					{
+						rank_.clear();
+						rank_.reserve(std::max(n + 1, 2 * rank_.capacity()));
+					}
+					if (tree_.capacity() < n + 1)
+					{
+						tree_.clear();
+						tree_.reserve(std::max(n + 1, 2 * tree_.capacity()));
+					}
+					// tree_[0] - заглушка (копия a[0]), чтобы узел k лежал по индексу k
+					rank_.resize_and_overwrite(n + 1, [n](std::size_t *r, std::size_t) {
+						r[0] = 0;
+						fill(r, n);
+						return n + 1;
+					});
+					const std::size_t *rank = rank_.data();
+					if constexpr (std::is_trivially_default_constructible_v<K> && std::is_trivially_destructible_v<K>)
+					{
+						tree_.resize_and_overwrite(n + 1, [&](K *t, std::size_t) {
+							for (std::size_t k = 0; k <= n; ++k)
+								t[k] = a[rank[k]];
+							return n + 1;
+						});
+					}
+					else
+					{
+						// Старые узлы перезаписываются присваиванием: их буферы
+						// (строки и т.п.) тоже переиспользуются
+						std::size_t keep = std::min(tree_.size(), n + 1);
+						for (std::size_t k = 0; k < keep; ++k)
+							tree_[k] = a[rank[k]];
+						for (std::size_t k = keep; k <= n; ++k)
+							tree_.push_back(a[rank[k]]);
+						tree_.erase(tree_.begin() + (n + 1), tree_.end());
+					}
+				}
+				catch (...)
+				{
+					tree_.clear();
+					rank_.clear();
+				}
+			}
+
+			template <typename P>
+			std::size_t partition_point(const K *a, std::size_t n, P pred) const
+			{
+				if (tree_.size() != n + 1)
+					return detail::branchless_partition_point(a, n, pred);
+				std::size_t k = descend(n, pred);
+				return k == 0 ? n : rank_[k];
+			}
+
+			// Равенство проверяется по узлу дерева, который уже в кэше:
+			// промах не читает ни rank_, ни отсортированные ключи
+			template <typename C>
+			std::size_t find(const K *a, std::size_t n, const K &key, const C &comp) const
+			{
+				if (tree_.size() != n + 1)
+					return BranchlessSearch::index<K>().find(a, n, key, comp);
+				std::size_t k = descend(n, [&](const K &x) { return comp(x, key); });
+				return k == 0 || comp(key, tree_[k]) ? n : rank_[k];
+			}
+
+		private:
+			// Потомки узла на несколько уровней вниз - одна линия, если дерево
+			// выровнено по её размеру
+			static constexpr std::size_t line = 64;
+			using tree_type = Vector<K, AlignedAllocator<K, line>>;
+			static_assert(AlignedAllocator<K, line>::alignment % line == 0, "tree must start on a cache line");
+
+			tree_type tree_;
+			Vector<std::size_t> rank_;
+
+			// Узел первого элемента, где pred ложно, или 0. Дети узла k -
+			// 2k и 2k + 1; его потомки на log2(ahead) уровней ниже - это
+			// ahead подряд идущих узлов с k * ahead, одна выровненная линия
+			template <typename P>
+			std::size_t descend(std::size_t n, P pred) const
+			{
+				constexpr std::size_t ahead = sizeof(K) < line ? line / sizeof(K) : 1;
+				const K *t = tree_.data();
+				std::size_t k = 1;
+				while (k <= n)
+				{
+					detail::prefetch(t + std::min(k * ahead, n));
+					k = 2 * k + (pred(t[k]) ? 1 : 0);
+				}
+				// Отбросить повороты направо после последнего поворота налево
+				return k >> (detail::ctz64(~static_cast<std::uint64_t>(k)) + 1);
+			}
+
+			// Симметричный обход без рекурсии даёт узлам позиции по
+			// возрастанию: от самого левого узла к следующему - в самый левый
+			// узел правого поддерева или вверх до первого поворота налево
+			static void fill(std::size_t *rank, std::size_t n) noexcept
+			{
+				std::size_t k = 1;
+				while (2 * k <= n)
+					k *= 2;
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					rank[k] = i;
+					if (2 * k + 1 <= n)
+					{
+						k = 2 * k + 1;
+						while (2 * k <= n)
+							k *= 2;
+					}
+					else
+						k >>= detail::ctz64(~static_cast<std::uint64_t>(k)) + 1;
+				}
+			}
+		};
+	};
+
+	// FlatSet<K>: отсортированные уникальные ключи в одном Vector. Поиск -
+	// политикой Search, вставка одного ключа - сдвиг за O(n), диапазон
+	// вставляется пачкой: хвост копируется отдельно, сортируется и сливается
+	// с ключами за один проход. Итераторы и ссылки инвалидируются любым
+	// изменением.
+	template <typename K, typename C = std::less<K>, typename Search = BranchlessSearch>
+	class FlatSet
+	{
+	public:
+		using key_type = K;
+		using value_type = K;
+		using key_compare = C;
+		using value_compare = C;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = const K &;
+		using const_reference = const K &;
+		using iterator = VectorIterator<const K>;
+		using const_iterator = VectorIterator<const K>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using container_type = Vector<K>;
+
+		FlatSet() = default;
+
+		explicit FlatSet(const C &comp) : comp_(comp) {}
+
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		FlatSet(InputIt first, InputIt last, const C &comp = C()) : comp_(comp)
+		{
+			insert(first, last);
+		}
+
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		FlatSet(sorted_unique_t, InputIt first, InputIt last, const C &comp = C()) : comp_(comp)
+		{
+			insert(sorted_unique, first, last);
+		}
+
+		FlatSet(std::initializer_list<K> il, const C &comp = C()) : FlatSet(il.begin(), il.end(), comp) {}
+
+		FlatSet &operator=(std::initializer_list<K> il)
+		{
+			FlatSet tmp(il, comp_);
+			swap(tmp);
+			return *this;
+		}
+
+		bool empty() const noexcept { return keys_.empty(); }
+		size_type size() const noexcept { return keys_.size(); }
+		size_type max_size() const noexcept { return keys_.max_size(); }
+		size_type capacity() const noexcept { return keys_.capacity(); }
+
+		void reserve(size_type n) { keys_.reserve(n); }
+		void shrink_to_fit() { keys_.shrink_to_fit(); }
+
+		void clear() noexcept
+		{
+			keys_.clear();
+			reindex();
+		}
+
+		std::pair<iterator, bool> insert(const K &key) { return emplace_key(key); }
+		std::pair<iterator, bool> insert(K &&key) { return emplace_key(std::move(key)); }
+
+		// Подсказка не используется: позиция всё равно ищется двоичным поиском
+		iterator insert(const_iterator, const K &key) { return emplace_key(key).first; }
+		iterator insert(const_iterator, K &&key) { return emplace_key(std::move(key)).first; }
+
+		template <typename... Args>
+		std::pair<iterator, bool> emplace(Args &&...args)
+		{
+			return emplace_key(K(std::forward<Args>(args)...));
+		}
+
+		// Пачка: сортировка хвоста, удаление повторов (остаётся первый) и одно
+		// слияние с ключами. Уже имеющиеся ключи не заменяются
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		void insert(InputIt first, InputIt last)
+		{
+			Vector<K> tail(first, last);
+			std::stable_sort(tail.begin(), tail.end(), comp_);
+			tail.erase(std::unique(tail.begin(), tail.end(), equiv()), tail.end());
+			merge(tail);
+		}
+
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		void insert(sorted_unique_t, InputIt first, InputIt last)
+		{
+			Vector<K> tail(first, last);
+			merge(tail);
+		}
+
+		void insert(std::initializer_list<K> il) { insert(il.begin(), il.end()); }
+
+		iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			size_type i = static_cast<size_type>(first - begin());
+			keys_.erase(keys_.begin() + i, keys_.begin() + (last - begin()));
+			reindex();
+			return begin() + i;
+		}
+
+		size_type erase(const K &key)
+		{
+			size_type i = lower_index(key);
+			if (i == size() || comp_(key, keys_[i]))
+				return 0;
+			erase(begin() + i);
+			return 1;
+		}
+
+		// Удалить ключи, для которых pred истинно; порядок сохраняется
+		template <typename Pred>
+		size_type remove_if(Pred pred)
+		{
+			size_type n = keys_.remove_if(pred);
+			if (n)
+				reindex();
+			return n;
+		}
+
+		iterator find(const K &key) const { return begin() + index_.find(keys_.data(), keys_.size(), key, comp_); }
+
+		bool contains(const K &key) const { return find(key) != end(); }
+		size_type count(const K &key) const { return contains(key) ? 1 : 0; }
+
+		iterator lower_bound(const K &key) const { return begin() + lower_index(key); }
+		iterator upper_bound(const K &key) const { return begin() + upper_index(key); }
+
+		std::pair<iterator, iterator> equal_range(const K &key) const
+		{
+			size_type i = lower_index(key);
+			size_type j = i + (i < size() && !comp_(key, keys_[i]) ? 1 : 0);
+			return { begin() + i, begin() + j };
+		}
+
+		key_compare key_comp() const { return comp_; }
+		value_compare value_comp() const { return comp_; }
+
+		// Отсортированные ключи как есть: для miv::simd, сериализации и т.п.
+		const container_type &keys() const noexcept { return keys_; }
+		const K *data() const noexcept { return keys_.data(); }
+
+		iterator begin() const noexcept { return keys_.begin(); }
+		iterator cbegin() const noexcept { return keys_.begin(); }
+		iterator end() const noexcept { return keys_.end(); }
+		iterator cend() const noexcept { return keys_.end(); }
+
+		reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+		reverse_iterator crbegin() const noexcept { return reverse_iterator(end()); }
+		reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+		reverse_iterator crend() const noexcept { return reverse_iterator(begin()); }
+
+		void swap(FlatSet &other) noexcept
+		{
+			using std::swap;
+			keys_.swap(other.keys_);
+			swap(comp_, other.comp_);
+			swap(index_, other.index_);
+		}
+
+		friend bool operator==(const FlatSet &x, const FlatSet &y) { return x.keys_ == y.keys_; }
+		friend bool operator!=(const FlatSet &x, const FlatSet &y) { return !(x == y); }
+		// Порядок - по компаратору набора, как у std::set
+		friend bool operator<(const FlatSet &x, const FlatSet &y)
+		{
+			return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end(), x.comp_);
+		}
+		friend bool operator>(const FlatSet &x, const FlatSet &y) { return y < x; }
+		friend bool operator<=(const FlatSet &x, const FlatSet &y) { return !(y < x); }
+		friend bool operator>=(const FlatSet &x, const FlatSet &y) { return !(x < y); }
+
+	private:
+		container_type keys_;
+		C comp_;
+		typename Search::template index<K> index_;
+
+		auto equiv() const
+		{
+			return [this](const K &a, const K &b) { return !comp_(a, b) && !comp_(b, a); };
+		}
+
+		size_type lower_index(const K &key) const
+		{
+			return index_.partition_point(keys_.data(), keys_.size(),
+										  [&](const K &x) { return comp_(x, key); });
+		}
+
+		size_type upper_index(const K &key) const
+		{
+			return index_.partition_point(keys_.data(), keys_.size(),
+										  [&](const K &x) { return !comp_(key, x); });
+		}
+
+		void reindex() noexcept { index_.rebuild(keys_.data(), keys_.size()); }
+
+		template <typename Key>
+		std::pair<iterator, bool> emplace_key(Key &&key)
+		{
+			size_type i = lower_index(key);
+			if (i < size() && !comp_(key, keys_[i]))
+				return { begin() + i, false };
+			keys_.insert(keys_.begin() + i, std::forward<Key>(key));
+			reindex();
+			return { begin() + i, true };
+		}
+
+		// Слияние отсортированного хвоста без повторов. В пустой набор хвост
+		// забирается целиком, хвост за последним ключом (растущие id) просто
+		// дописывается. Иначе ключи сливаются в новый буфер за один проход:
+		// при совпадении остаётся старый. Если перенос ключа не бросает -
+		// сильная гарантия
+		void merge(Vector<K> &tail)
+		{
+			if (tail.empty())
+				return;
+			if (keys_.empty())
+				keys_.swap(tail);
+			else if (comp_(keys_.back(), tail.front()))
+				keys_.append_range(std::make_move_iterator(tail.begin()), std::make_move_iterator(tail.end()));
+			else
+			{
+				container_type out;
+				out.reserve(keys_.size() + tail.size());
+				auto a = keys_.begin(), ae = keys_.end();
+				auto b = tail.begin(), be = tail.end();
+				while (a != ae && b != be)
+				{
+					if (comp_(*b, *a))
+						out.push_back(std::move_if_noexcept(*b++));
+					else
+					{
+						if (!comp_(*a, *b))
+							++b;
+						out.push_back(std::move_if_noexcept(*a++));
+					}
+				}
+				for (; a != ae; ++a)
+					out.push_back(std::move_if_noexcept(*a));
+				for (; b != be; ++b)
+					out.push_back(std::move_if_noexcept(*b));
+				keys_.swap(out);
+			}
+			reindex();
+		}
+	};
+
+	template <typename K, typename C, typename S>
+	void swap(FlatSet<K, C, S> &a, FlatSet<K, C, S> &b) noexcept
+	{
+		a.swap(b);
+	}
+
+	template <typename K, typename C, typename S, typename Pred>
+	typename FlatSet<K, C, S>::size_type erase_if(FlatSet<K, C, S> &s, Pred pred)
+	{
+		return s.remove_if(pred);
+	}
+}
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "Vector.h"
+
+namespace miv
+{
+	// IncrementalVector<T, A, Step>: вектор с ограниченной задержкой роста.
+	// Когда буфер заполнен, новый блок (вдвое больше) выделяется сразу, но
+	// элементы переносятся в него не одним O(n) проходом, а по Step штук на
+	// каждой следующей модификации. Ни один push_back не делает больше
+	// O(Step) работы, кроме самого выделения памяти.
+	//
+	// Во время миграции индексы [moved_, old_n_) живут в старом блоке,
+	// остальные - в новом, поэтому operator[] делает одну проверку диапазона.
+	// Перенос заканчивается раньше, чем заполнится новый блок: на каждую
+	// модификацию свободных слотов убывает не больше одного, а неперенесённых
+	// элементов - не меньше одного. Хранение не непрерывно, поэтому data()
+	// нет; итераторы индексные.
+	template <typename T, typename A = Allocator<T>, std::size_t Step = 4>
+	class IncrementalVector
+	{
+		static_assert(Step > 0, "IncrementalVector requires Step > 0");
+
+	public:
+		using value_type = T;
+		using allocator_type = A;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T &;
+		using const_reference = const T &;
+		using pointer = T *;
+		using const_pointer = const T *;
+		using iterator = SegmentIterator<IncrementalVector, T>;
+		using const_iterator = SegmentIterator<const IncrementalVector, const T>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using alloc_traits = std::allocator_traits<allocator_type>;
+
+		static constexpr size_type migration_step = Step;
+
+		IncrementalVector(const allocator_type &alloc = allocator_type()) noexcept
+			: alloc_(alloc), elem_(nullptr), sz_(0), space_(0), old_(nullptr), old_space_(0), moved_(0), old_n_(0), trimmed_(0)
+		{
+		}
+
+		IncrementalVector(std::initializer_list<T> il,
+						  const allocator_type &alloc = allocator_type())
+			: IncrementalVector(alloc)
+		{
+			reserve(il.size());
+			for (const T &v : il)
+				push_back(v);
+		}
+
+		IncrementalVector(const IncrementalVector &other)
+			: IncrementalVector(alloc_traits::select_on_container_copy_construction(other.alloc_))
+		{
+			reserve(other.sz_);
+			for (size_type i = 0; i < other.sz_; ++i)
+				push_back(other[i]);
+		}
+
+		IncrementalVector(IncrementalVector &&other) noexcept
+			: alloc_(std::move(other.alloc_)), elem_(other.elem_), sz_(other.sz_), space_(other.space_),
+			  old_(other.old_), old_space_(other.old_space_), moved_(other.moved_), old_n_(other.old_n_),
+			  trimmed_(other.trimmed_)
+		{
+			other.elem_ = other.old_ = nullptr;
+			other.sz_ = other.space_ = other.old_space_ = other.moved_ = other.old_n_ = other.trimmed_ = 0;
+		}
+
+		IncrementalVector &operator=(const IncrementalVector &other)
+		{
+			if (this != &other)
+			{
+				IncrementalVector tmp(other);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		IncrementalVector &operator=(IncrementalVector &&other) noexcept
+		{
+			if (this != &other)
+			{
+				IncrementalVector tmp(std::move(other));
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		~IncrementalVector()
+		{
+			clear();
+			if (elem_)
+				alloc_traits::deallocate(alloc_, elem_, space_);
+		}
+
+		size_type size() const noexcept { return sz_; }
+		size_type capacity() const noexcept { return space_; }
+		bool empty() const noexcept { return sz_ == 0; }
+
+		// Идёт ли перенос из старого блока
+		bool migrating() const noexcept { return old_ != nullptr; }
+
+		// Доделать перенос за один вызов (O(n))
+		void finish_migration()
+		{
+			if (old_)
+				migrate(old_n_ - moved_);
+		}
+
+		// Явный reserve переносит всё сразу: вызывающий сам выбирает, где платить O(n)
+		void reserve(size_type new_cap)
+		{
+			finish_migration();
+			if (new_cap <= space_)
+				return;
+			if (elem_ && detail::expand(alloc_, elem_, space_, new_cap))
+				return;
+			pointer new_elem = alloc_traits::allocate(alloc_, new_cap);
+			detail::relocate(alloc_, elem_, sz_, new_elem);
+			if (elem_)
+				alloc_traits::deallocate(alloc_, elem_, space_);
+			elem_ = new_elem;
+			space_ = new_cap;
+		}
+
+		void push_back(const T &value)
+		{
+			emplace_back(value);
+		}
+		void push_back(T &&value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		// Элемент конструируется до шага переноса: аргумент может ссылаться на
+		// элемент самого вектора, который перенос уничтожил бы
+		template <typename... Args>
+		reference emplace_back(Args &&...args)
+		{
+			if (sz_ == space_)
+				grow();
+			alloc_traits::construct(alloc_, elem_ + sz_, std::forward<Args>(args)...);
+			++sz_;
+			if (old_)
+				advance_migration();
+			return *slot(sz_ - 1);
+		}
+
+		void pop_back() noexcept
+		{
+			if (old_)
+				advance_migration();
+			--sz_;
+			if (old_ && sz_ < old_n_)
+			{
+				// последний элемент ещё в старом блоке
+				alloc_traits::destroy(alloc_, old_ + sz_);
+				old_n_ = sz_;
+				if (moved_ == old_n_)
+					release_old();
+			}
+			else
+			{
+				alloc_traits::destroy(alloc_, elem_ + sz_);
+			}
+		}
+
+		void clear() noexcept
+		{
+			for (size_type i = 0; i < sz_; ++i)
+				alloc_traits::destroy(alloc_, slot(i));
+			sz_ = 0;
+			if (old_)
+			{
+				old_n_ = moved_;
+				release_old();
+			}
+		}
+
+		reference operator[](size_type i) noexcept { return *slot(i); }
+		const_reference operator[](size_type i) const noexcept { return *slot(i); }
+
+		reference at(size_type i)
+		{
+			if (i >= sz_)
+				throw Range_error(i);
+			return *slot(i);
+		}
+		const_reference at(size_type i) const
+		{
+			if (i >= sz_)
+				throw Range_error(i);
+			return *slot(i);
+		}
+
+		reference front() noexcept { return *slot(0); }
+		const_reference front() const noexcept { return *slot(0); }
+		reference back() noexcept { return *slot(sz_ - 1); }
+		const_reference back() const noexcept { return *slot(sz_ - 1); }
+
+		iterator begin() noexcept { return iterator(this, 0); }
+		const_iterator begin() const noexcept { return const_iterator(this, 0); }
+		const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+		iterator end() noexcept { return iterator(this, sz_); }
+		const_iterator end() const noexcept { return const_iterator(this, sz_); }
+		const_iterator cend() const noexcept { return const_iterator(this, sz_); }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+		void swap(IncrementalVector &other) noexcept
+		{
+			std::swap(alloc_, other.alloc_);
+			std::swap(elem_, other.elem_);
+			std::swap(sz_, other.sz_);
+			std::swap(space_, other.space_);
+			std::swap(old_, other.old_);
+			std::swap(old_space_, other.old_space_);
+			std::swap(moved_, other.moved_);
+			std::swap(old_n_, other.old_n_);
+			std::swap(trimmed_, other.trimmed_);
+		}
+
+		allocator_type get_allocator() const noexcept
+		{
+			return alloc_;
+		}
+
+		size_type max_size() const noexcept
+		{
+			return alloc_traits::max_size(alloc_);
+		}
+
+	private:
+		allocator_type alloc_;
+		T *elem_; // новый (или единственный) блок
+		size_type sz_, space_;
+		T *old_; // старый блок во время миграции
+		size_type old_space_;
+		size_type moved_, old_n_; // [moved_, old_n_) ещё в old_
+		std::uintptr_t trimmed_;  // до этого адреса страницы old_ уже отданы системе
+
+		T *slot(size_type i) const noexcept
+		{
+			return i - moved_ < old_n_ - moved_ ? old_ + i : elem_ + i;
+		}
+
+		// Новый блок вдвое больше; старый остаётся источником миграции.
+		// Рост на месте (try_expand) миграции не требует; reallocate не
+		// используется - mremap большого блока тоже O(n) по страницам
+		void grow()
+		{
+			// перенос мог застрять на исключениях конструктора перемещения
+			finish_migration();
+			if (space_ == 0)
+			{
+				elem_ = alloc_traits::allocate(alloc_, 8);
+				space_ = 8;
+				return;
+			}
+			if constexpr (detail::has_try_expand_v<A>)
+			{
+				if (alloc_.try_expand(elem_, space_, 2 * space_))
+				{
+					space_ *= 2;
+					return;
+				}
+			}
+			pointer fresh = alloc_traits::allocate(alloc_, 2 * space_);
+			old_ = elem_;
+			old_space_ = space_;
+			moved_ = 0;
+			old_n_ = sz_;
+			trimmed_ = reinterpret_cast<std::uintptr_t>(old_);
+			elem_ = fresh;
+			space_ *= 2;
+		}
+
+		void migrate(size_type k)
+		{
+			k = std::min(k, old_n_ - moved_);
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				detail::relocate(alloc_, old_ + moved_, k, elem_ + moved_);
+				moved_ += k;
+			}
+			else
+			{
+				// по одному элементу, чтобы исключение не оставило дыр
+				for (; k; --k, ++moved_)
+					detail::relocate(alloc_, old_ + moved_, 1, elem_ + moved_);
+			}
+			if (moved_ == old_n_)
+				release_old();
+			else
+				trim_old();
+		}
+
+		// Перенесённый префикс большого старого блока отдаётся системе кусками
+		// через madvise: иначе освобождение блока в конце миграции - та же
+		// пауза O(n), только по страницам
+		void trim_old() noexcept
+		{
+#ifdef MIV_HAS_MMAP
+			constexpr std::uintptr_t batch = std::uintptr_t(256) << 10;
+			if (old_space_ * sizeof(T) < detail::mmap_threshold)
+				return;
+			std::uintptr_t ps = detail::page_size();
+			std::uintptr_t from = (trimmed_ + ps - 1) & ~(ps - 1);
+			std::uintptr_t to = reinterpret_cast<std::uintptr_t>(old_ + moved_) & ~(ps - 1);
+			if (to >= from + batch)
+			{
+				::madvise(reinterpret_cast<void *>(from), to - from, MADV_DONTNEED);
+				trimmed_ = to;
+			}
+#endif
+		}
+
+		// Шаг переноса не должен ломать уже выполненную операцию: если
+		// перемещение бросило исключение, элемент остаётся в старом блоке и
+		// переносится позже (в крайнем случае - в finish_migration из grow)
+		void advance_migration() noexcept
+		{
+			try
+			{
+				migrate(Step);
+			}
+			catch (...)
+			{
+			}
+		}
+
+		void release_old() noexcept
+		{
+			for (size_type i = moved_; i < old_n_; ++i)
+				alloc_traits::destroy(alloc_, old_ + i);
+			alloc_traits::deallocate(alloc_, old_, old_space_);
+			old_ = nullptr;
+			old_space_ = moved_ = old_n_ = 0;
+			trimmed_ = 0;
+		}
+	};
+
+	template <typename T, typename A, std::size_t Step>
+	void swap(IncrementalVector<T, A, Step> &a, IncrementalVector<T, A, Step> &b) noexcept
+	{
+		a.swap(b);
+	}
+}
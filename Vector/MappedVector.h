@@ -0,0 +1,332 @@
+#pragma once
+
+#include "Vector.h"
+#include <string>
+#include <system_error>
+
+#ifdef MIV_HAS_MMAP
+#include <fcntl.h>
+#include <sys/stat.h>
+
+namespace miv
+{
+	enum class MapMode
+	{
+		read_only,	// файл отображается без копирования; записи в элементы не попадают в файл
+		read_write, // файл создаётся при отсутствии, растёт через ftruncate + mremap
+	};
+
+	// Вектор тривиально копируемых записей поверх отображённого в память файла.
+	// Формат файла - голый массив T, длина файла = size() * sizeof(T).
+	//
+	// В read_write файл на время работы растёт до capacity(); flush() и
+	// закрытие обрезают его до size() и сбрасывают страницы на диск.
+	// read_only отображает файл MAP_PRIVATE: элементы можно менять (страницы
+	// копируются при записи), но размер менять нельзя.
+	template <typename T>
+	class MappedVector
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "MappedVector requires a trivially copyable T");
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T &;
+		using const_reference = const T &;
+		using pointer = T *;
+		using const_pointer = const T *;
+		using iterator = VectorIterator<T>;
+		using const_iterator = VectorIterator<const T>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		MappedVector() noexcept
+			: elem_(nullptr), sz_(0), space_(0), map_len_(0), fd_(-1), mode_(MapMode::read_only)
+		{
+		}
+
+		explicit MappedVector(const std::string &path, MapMode mode = MapMode::read_only)
+			: MappedVector()
+		{
+			open(path, mode);
+		}
+
+		MappedVector(const MappedVector &) = delete;
+		MappedVector &operator=(const MappedVector &) = delete;
+
+		MappedVector(MappedVector &&other) noexcept
+			: MappedVector()
+		{
+			swap(other);
+		}
+
+		MappedVector &operator=(MappedVector &&other) noexcept
+		{
+			if (this != &other)
+			{
+				close();
+				swap(other);
+			}
+			return *this;
+		}
+
+		~MappedVector()
+		{
+			close();
+		}
+
+		void open(const std::string &path, MapMode mode = MapMode::read_only)
+		{
+			close();
+			bool rw = mode == MapMode::read_write;
+			int fd = ::open(path.c_str(), rw ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+			if (fd < 0)
+				throw_errno("open " + path);
+			struct stat st;
+			if (::fstat(fd, &st) != 0)
+			{
+				int err = errno;
+				::close(fd);
+				throw std::system_error(err, std::generic_category(), "fstat " + path);
+			}
+			size_type bytes = static_cast<size_type>(st.st_size);
+			if (bytes % sizeof(T) != 0)
+			{
+				::close(fd);
+				throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+										path + ": size is not a multiple of the record size");
+			}
+			fd_ = fd;
+			mode_ = mode;
+			try
+			{
+				map(bytes);
+			}
+			catch (...)
+			{
+				::close(fd_);
+				fd_ = -1;
+				throw;
+			}
+			sz_ = space_ = bytes / sizeof(T);
+			// отображение read_only держит файл само, дескриптор больше не нужен
+			if (!rw)
+			{
+				::close(fd_);
+				fd_ = -1;
+			}
+		}
+
+		// Обрезает файл до size(), снимает отображение. Ошибки игнорируются:
+		// чтобы их увидеть, вызовите flush() перед close()
+		void close() noexcept
+		{
+			if (fd_ >= 0)
+				(void)::ftruncate(fd_, static_cast<off_t>(sz_ * sizeof(T)));
+			if (map_len_)
+				::munmap(elem_, map_len_);
+			if (fd_ >= 0)
+				::close(fd_);
+			elem_ = nullptr;
+			sz_ = space_ = map_len_ = 0;
+			fd_ = -1;
+		}
+
+		// Обрезает файл до size() и синхронно записывает изменённые страницы
+		void flush()
+		{
+			require_writable();
+			set_file_size(sz_);
+			if (sz_ && ::msync(elem_, detail::round_to_pages(sz_ * sizeof(T)), MS_SYNC) != 0)
+				throw_errno("msync");
+		}
+
+		bool is_open() const noexcept { return map_len_ != 0 || fd_ >= 0; }
+		bool writable() const noexcept { return fd_ >= 0; }
+
+		size_type size() const noexcept { return sz_; }
+		size_type capacity() const noexcept { return space_; }
+		bool empty() const noexcept { return sz_ == 0; }
+
+		void reserve(size_type n)
+		{
+			require_writable();
+			if (n <= space_)
+				return;
+			set_file_size(n);
+			map(n * sizeof(T));
+		}
+
+		// Рост может перенести отображение: value копируется до него
+		void resize(size_type n, const T &value = T())
+		{
+			if (n > sz_)
+			{
+				T tmp(value);
+				grow_for(n);
+				std::uninitialized_fill(elem_ + sz_, elem_ + n, tmp);
+			}
+			else
+			{
+				require_writable();
+			}
+			sz_ = n;
+		}
+
+		void clear()
+		{
+			require_writable();
+			sz_ = 0;
+		}
+
+		void push_back(const T &value)
+		{
+			emplace_back(value);
+		}
+
+		// m.push_back(m[0]) корректен: элемент строится до роста, который
+		// может перенести отображение (mremap или новый mmap)
+		template <typename... Args>
+		reference emplace_back(Args &&...args)
+		{
+			T tmp(std::forward<Args>(args)...);
+			grow_for(sz_ + 1);
+			::new (static_cast<void *>(elem_ + sz_)) T(tmp);
+			return elem_[sz_++];
+		}
+
+		void pop_back()
+		{
+			require_writable();
+			if (sz_ > 0)
+				--sz_;
+		}
+
+		template <typename InputIt>
+		void append_range(InputIt first, InputIt last)
+		{
+			if constexpr (detail::is_forward_iterator_v<InputIt>)
+			{
+				size_type n = static_cast<size_type>(std::distance(first, last));
+				grow_for(sz_ + n);
+				std::uninitialized_copy(first, last, elem_ + sz_);
+				sz_ += n;
+			}
+			else
+			{
+				for (; first != last; ++first)
+					emplace_back(*first);
+			}
+		}
+
+		reference operator[](size_type i) noexcept { return elem_[i]; }
+		const_reference operator[](size_type i) const noexcept { return elem_[i]; }
+
+		reference at(size_type i)
+		{
+			if (i >= sz_)
+				throw Range_error(i);
+			return elem_[i];
+		}
+		const_reference at(size_type i) const
+		{
+			if (i >= sz_)
+				throw Range_error(i);
+			return elem_[i];
+		}
+
+		reference front() noexcept { return elem_[0]; }
+		const_reference front() const noexcept { return elem_[0]; }
+		reference back() noexcept { return elem_[sz_ - 1]; }
+		const_reference back() const noexcept { return elem_[sz_ - 1]; }
+
+		pointer data() noexcept { return elem_; }
+		const_pointer data() const noexcept { return elem_; }
+
+		iterator begin() noexcept { return iterator(elem_); }
+		const_iterator begin() const noexcept { return const_iterator(elem_); }
+		const_iterator cbegin() const noexcept { return const_iterator(elem_); }
+		iterator end() noexcept { return iterator(elem_ + sz_); }
+		const_iterator end() const noexcept { return const_iterator(elem_ + sz_); }
+		const_iterator cend() const noexcept { return const_iterator(elem_ + sz_); }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+		void swap(MappedVector &other) noexcept
+		{
+			std::swap(elem_, other.elem_);
+			std::swap(sz_, other.sz_);
+			std::swap(space_, other.space_);
+			std::swap(map_len_, other.map_len_);
+			std::swap(fd_, other.fd_);
+			std::swap(mode_, other.mode_);
+		}
+
+	private:
+		T *elem_;
+		size_type sz_;
+		size_type space_;	// длина файла в элементах
+		size_type map_len_; // длина отображения в байтах, кратна странице
+		int fd_;			// -1 для read_only и закрытого вектора
+		MapMode mode_;
+
+		[[noreturn]] static void throw_errno(const std::string &what)
+		{
+			throw std::system_error(errno, std::generic_category(), what);
+		}
+
+		void require_writable() const
+		{
+			if (fd_ < 0)
+				throw std::system_error(std::make_error_code(std::errc::operation_not_permitted),
+										"MappedVector is not opened for writing");
+		}
+
+		void set_file_size(size_type n)
+		{
+			if (::ftruncate(fd_, static_cast<off_t>(n * sizeof(T))) != 0)
+				throw_errno("ftruncate");
+			space_ = n;
+		}
+
+		// Растит отображение до bytes: mremap переносит страницы без копирования,
+		// иначе файл отображается заново (содержимое лежит в файле)
+		void map(size_type bytes)
+		{
+			size_type len = detail::round_to_pages(bytes);
+			if (len <= map_len_)
+				return;
+			void *p = map_len_ ? detail::remap_pages(elem_, map_len_, len, true) : nullptr;
+			if (!p)
+			{
+				bool rw = mode_ == MapMode::read_write;
+				p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, rw ? MAP_SHARED : MAP_PRIVATE, fd_, 0);
+				if (p == MAP_FAILED)
+					throw_errno("mmap");
+				if (map_len_)
+					::munmap(elem_, map_len_);
+			}
+			elem_ = static_cast<T *>(p);
+			map_len_ = len;
+		}
+
+		// Геометрический рост файла, не меньше страницы
+		void grow_for(size_type n)
+		{
+			require_writable();
+			if (n > space_)
+				reserve(std::max({ n, 2 * space_, detail::page_size() / sizeof(T) }));
+		}
+	};
+
+	template <typename T>
+	void swap(MappedVector<T> &a, MappedVector<T> &b) noexcept
+	{
+		a.swap(b);
+	}
+}
+#endif
@@ -0,0 +1,500 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include "Vector.h"
+
+namespace miv
+{
+	namespace parallel
+	{
+		constexpr std::size_t cache_line = 64;
+
+		// Пул потоков с work stealing: у каждого рабочего своя очередь под своим
+		// mutex. Рабочий берёт задачи с хвоста своей очереди (LIFO, тёплый кэш),
+		// а при пустой очереди крадёт с головы чужих. Поток, ожидающий задачи
+		// (TaskGroup::wait), тоже выполняет их, поэтому пул из n рабочих даёт
+		// n + 1 исполнителей.
+		class ThreadPool
+		{
+		public:
+			explicit ThreadPool(unsigned workers = default_workers())
+				: queues_(workers ? new Queue[workers] : nullptr), count_(workers),
+				  pending_(0), next_(0), stop_(false)
+			{
+				threads_.reserve(workers);
+				for (unsigned i = 0; i < workers; ++i)
+					threads_.emplace_back([this, i] { work(i); });
+			}
+
+			ThreadPool(const ThreadPool &) = delete;
+			ThreadPool &operator=(const ThreadPool &) = delete;
+
+			~ThreadPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(sleep_m_);
+					stop_ = true;
+				}
+				wake_.notify_all();
+				for (auto &t : threads_)
+					t.join();
+			}
+
+			// Пул по умолчанию: hardware_concurrency() - 1 рабочих
+			static ThreadPool &instance()
+			{
+				static ThreadPool pool;
+				return pool;
+			}
+
+			static unsigned default_workers() noexcept
+			{
+				unsigned hw = std::thread::hardware_concurrency();
+				return hw > 1 ? hw - 1 : 0;
+			}
+
+			unsigned size() const noexcept { return count_; }
+
+			// Из рабочего потока задача кладётся в его очередь, иначе - по кругу
+			void submit(std::function<void()> task)
+			{
+				if (count_ == 0)
+					return task();
+				unsigned q = current_pool() == this ? current_index()
+													: next_.fetch_add(1, std::memory_order_relaxed) % count_;
+				{
+					std::lock_guard<std::mutex> lock(queues_[q].m);
+					queues_[q].tasks.push_back(std::move(task));
+				}
+				pending_.fetch_add(1, std::memory_order_release);
+				{
+					std::lock_guard<std::mutex> lock(sleep_m_);
+				}
+				wake_.notify_one();
+			}
+
+			// Выполнить одну задачу из любой очереди; false, если задач нет
+			bool run_one()
+			{
+				unsigned self = current_pool() == this ? current_index() : 0;
+				std::function<void()> task;
+				if (!take(self, task))
+					return false;
+				task();
+				return true;
+			}
+
+		private:
+			struct alignas(cache_line) Queue
+			{
+				std::mutex m;
+				std::deque<std::function<void()>> tasks;
+			};
+
+			std::unique_ptr<Queue[]> queues_;
+			unsigned count_;
+			Vector<std::thread> threads_;
+			std::atomic<std::size_t> pending_;
+			std::atomic<unsigned> next_;
+			std::mutex sleep_m_;
+			std::condition_variable wake_;
+			bool stop_;
+
+			static ThreadPool *&current_pool() noexcept
+			{
+				static thread_local ThreadPool *pool = nullptr;
+				return pool;
+			}
+			static unsigned &current_index() noexcept
+			{
+				static thread_local unsigned index = 0;
+				return index;
+			}
+
+			bool take(unsigned self, std::function<void()> &task)
+			{
+				if (pending_.load(std::memory_order_acquire) == 0)
+					return false;
+				{
+					Queue &own = queues_[self];
+					std::lock_guard<std::mutex> lock(own.m);
+					if (!own.tasks.empty())
+					{
+						task = std::move(own.tasks.back());
+						own.tasks.pop_back();
+						pending_.fetch_sub(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+				for (unsigned i = 1; i < count_; ++i)
+				{
+					Queue &victim = queues_[(self + i) % count_];
+					std::lock_guard<std::mutex> lock(victim.m);
+					if (!victim.tasks.empty())
+					{
+						task = std::move(victim.tasks.front());
+						victim.tasks.pop_front();
+						pending_.fetch_sub(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void work(unsigned index)
+			{
+				current_pool() = this;
+				current_index() = index;
+				std::function<void()> task;
+				for (;;)
+				{
+					if (take(index, task))
+					{
+						task();
+						task = nullptr;
+						continue;
+					}
+					std::unique_lock<std::mutex> lock(sleep_m_);
+					wake_.wait(lock, [this] { return stop_ || pending_.load(std::memory_order_acquire) > 0; });
+					if (stop_)
+						return;
+				}
+			}
+		};
+
+		// Группа задач fork-join: wait() помогает пулу, пока группа не опустеет,
+		// и пробрасывает первое исключение из задач
+		class TaskGroup
+		{
+		public:
+			explicit TaskGroup(ThreadPool &pool) noexcept : pool_(pool), left_(0) {}
+
+			TaskGroup(const TaskGroup &) = delete;
+			TaskGroup &operator=(const TaskGroup &) = delete;
+
+			~TaskGroup()
+			{
+				drain();
+			}
+
+			template <typename F>
+			void run(F f)
+			{
+				left_.fetch_add(1, std::memory_order_relaxed);
+				try
+				{
+					pool_.submit([this, f]() mutable {
+						try
+						{
+							f();
+						}
+						catch (...)
+						{
+							std::lock_guard<std::mutex> lock(error_m_);
+							if (!error_)
+								error_ = std::current_exception();
+						}
+						left_.fetch_sub(1, std::memory_order_release);
+					});
+				}
+				catch (...)
+				{
+					left_.fetch_sub(1, std::memory_order_relaxed);
+					throw;
+				}
+			}
+
+			void wait()
+			{
+				drain();
+				if (error_)
+					std::rethrow_exception(std::exchange(error_, nullptr));
+			}
+
+		private:
+			ThreadPool &pool_;
+			std::atomic<std::size_t> left_;
+			std::mutex error_m_;
+			std::exception_ptr error_;
+
+			void drain() noexcept
+			{
+				while (left_.load(std::memory_order_acquire) != 0)
+					if (!pool_.run_one())
+						std::this_thread::yield();
+			}
+		};
+
+		// pool == nullptr - ThreadPool::instance(); grain - минимальное число
+		// элементов на задачу, 0 - подобрать по размеру элемента
+		struct Options
+		{
+			ThreadPool *pool = nullptr;
+			std::size_t grain = 0;
+		};
+
+		namespace detail
+		{
+			constexpr std::size_t default_grain_bytes = 16 * 1024;
+			constexpr std::size_t tasks_per_thread = 4;
+
+			// Значение в отдельной кэш-линии, чтобы частичные результаты
+			// соседних задач не делили линию
+			template <typename T>
+			struct alignas(cache_line) Padded
+			{
+				std::optional<T> value;
+			};
+
+			inline ThreadPool &pool_of(const Options &opt)
+			{
+				return opt.pool ? *opt.pool : ThreadPool::instance();
+			}
+
+			// Границы кусков [b[i], b[i+1]): не меньше grain элементов, не больше
+			// tasks_per_thread кусков на исполнителя; внутренние границы сдвинуты
+			// на начало кэш-линии, чтобы пишущие задачи не делили линии
+			template <typename T>
+			Vector<std::size_t> split(const T *first, std::size_t n, std::size_t grain, unsigned executors)
+			{
+				if (grain == 0)
+					grain = std::max<std::size_t>(default_grain_bytes / sizeof(T), 1);
+				std::size_t chunks = std::min<std::size_t>((n + grain - 1) / grain, std::size_t(executors) * tasks_per_thread);
+				chunks = std::max<std::size_t>(chunks, 1);
+				std::size_t step = (n + chunks - 1) / chunks;
+
+				Vector<std::size_t> bounds;
+				bounds.reserve(chunks + 1);
+				bounds.push_back(0);
+				for (std::size_t i = 1; i < chunks; ++i)
+				{
+					std::size_t b = i * step;
+					auto addr = reinterpret_cast<std::uintptr_t>(first + b);
+					std::size_t gap = (cache_line - addr % cache_line) % cache_line;
+					b += (gap + sizeof(T) - 1) / sizeof(T);
+					if (b >= n)
+						break;
+					if (b > bounds.back())
+						bounds.push_back(b);
+				}
+				if (n > bounds.back() || n == 0)
+					bounds.push_back(n);
+				return bounds;
+			}
+
+			// body(begin, end, chunk) для каждого куска; первый кусок выполняет
+			// вызывающий поток
+			template <typename Body>
+			void run_chunks(ThreadPool &pool, const Vector<std::size_t> &bounds, Body &body)
+			{
+				std::size_t chunks = bounds.size() - 1;
+				if (chunks == 1 || pool.size() == 0)
+				{
+					for (std::size_t c = 0; c < chunks; ++c)
+						body(bounds[c], bounds[c + 1], c);
+					return;
+				}
+				TaskGroup group(pool);
+				for (std::size_t c = 1; c < chunks; ++c)
+					group.run([&body, &bounds, c] { body(bounds[c], bounds[c + 1], c); });
+				body(bounds[0], bounds[1], 0);
+				group.wait();
+			}
+
+			// Попарное слияние соседних кусков раундами: join(first, mid, last)
+			// объединяет [first, mid) и [mid, last); раунды идут параллельно
+			template <typename Join>
+			void merge_rounds(ThreadPool &pool, Vector<std::size_t> bounds, Join join)
+			{
+				while (bounds.size() > 2)
+				{
+					Vector<std::size_t> next;
+					next.reserve(bounds.size() / 2 + 2);
+					TaskGroup group(pool);
+					std::size_t i = 0;
+					for (; i + 2 < bounds.size(); i += 2)
+					{
+						std::size_t a = bounds[i], m = bounds[i + 1], b = bounds[i + 2];
+						group.run([&join, a, m, b] { join(a, m, b); });
+						next.push_back(a);
+					}
+					next.push_back(bounds[i]);
+					if (i + 1 < bounds.size())
+						next.push_back(bounds[i + 1]);
+					group.wait();
+					bounds = std::move(next);
+				}
+			}
+		}
+
+		// f(x) для каждого элемента [first, first + n)
+		template <typename T, typename F>
+		void for_each(T *first, std::size_t n, F f, Options opt = {})
+		{
+			ThreadPool &pool = detail::pool_of(opt);
+			auto bounds = detail::split(first, n, opt.grain, pool.size() + 1);
+			auto body = [first, &f](std::size_t b, std::size_t e, std::size_t) {
+				for (std::size_t i = b; i < e; ++i)
+					f(first[i]);
+			};
+			detail::run_chunks(pool, bounds, body);
+		}
+
+		// out[i] = f(in[i]); куски режутся по выходному массиву
+		template <typename T, typename U, typename F>
+		void transform(const T *in, std::size_t n, U *out, F f, Options opt = {})
+		{
+			ThreadPool &pool = detail::pool_of(opt);
+			auto bounds = detail::split(out, n, opt.grain, pool.size() + 1);
+			auto body = [in, out, &f](std::size_t b, std::size_t e, std::size_t) {
+				for (std::size_t i = b; i < e; ++i)
+					out[i] = f(in[i]);
+			};
+			detail::run_chunks(pool, bounds, body);
+		}
+
+		// Свёртка op по кускам, затем частичные результаты сворачиваются слева
+		// направо с init: op должна быть ассоциативной, коммутативность не нужна
+		template <typename T, typename R, typename Op>
+		R reduce(const T *first, std::size_t n, R init, Op op, Options opt = {})
+		{
+			ThreadPool &pool = detail::pool_of(opt);
+			auto bounds = detail::split(first, n, opt.grain, pool.size() + 1);
+			Vector<detail::Padded<R>> partial(bounds.size() - 1);
+			auto body = [first, &op, &partial](std::size_t b, std::size_t e, std::size_t c) {
+				if (b == e)
+					return;
+				R acc = first[b];
+				for (std::size_t i = b + 1; i < e; ++i)
+					acc = op(std::move(acc), first[i]);
+				partial[c].value.emplace(std::move(acc));
+			};
+			detail::run_chunks(pool, bounds, body);
+			for (auto &p : partial)
+				if (p.value)
+					init = op(std::move(init), std::move(*p.value));
+			return init;
+		}
+
+		// Сортировка кусков std::sort, затем попарные раунды std::inplace_merge
+		template <typename T, typename Compare>
+		void sort(T *first, std::size_t n, Compare comp, Options opt = {})
+		{
+			ThreadPool &pool = detail::pool_of(opt);
+			auto bounds = detail::split(first, n, opt.grain, pool.size() + 1);
+			auto body = [first, &comp](std::size_t b, std::size_t e, std::size_t) {
+				std::sort(first + b, first + e, comp);
+			};
+			detail::run_chunks(pool, bounds, body);
+			detail::merge_rounds(pool, std::move(bounds), [first, &comp](std::size_t a, std::size_t m, std::size_t b) {
+				std::inplace_merge(first + a, first + m, first + b, comp);
+			});
+		}
+
+		// Устойчивое разбиение: куски разбиваются независимо, затем соседние
+		// пары [T1 F1][T2 F2] склеиваются поворотом F1 T2. Возвращает число
+		// элементов, удовлетворяющих pred
+		template <typename T, typename Pred>
+		std::size_t stable_partition(T *first, std::size_t n, Pred pred, Options opt = {})
+		{
+			ThreadPool &pool = detail::pool_of(opt);
+			auto bounds = detail::split(first, n, opt.grain, pool.size() + 1);
+			// mid[c] - граница разбиения внутри куска, начинающегося с bounds[c]
+			Vector<detail::Padded<std::size_t>> mid(bounds.size());
+			auto body = [first, &pred, &mid](std::size_t b, std::size_t e, std::size_t c) {
+				mid[c].value = std::stable_partition(first + b, first + e, pred) - first;
+			};
+			detail::run_chunks(pool, bounds, body);
+
+			// кусок, начинающийся с a, после склейки хранит свою границу в mid[chunk(a)]
+			auto chunk = [&bounds](std::size_t a) {
+				return static_cast<std::size_t>(std::lower_bound(bounds.begin(), bounds.end(), a) - bounds.begin());
+			};
+			detail::merge_rounds(pool, bounds, [first, &mid, &chunk](std::size_t a, std::size_t m, std::size_t) {
+				std::size_t &left = *mid[chunk(a)].value;
+				std::size_t right = *mid[chunk(m)].value;
+				std::rotate(first + left, first + m, first + right);
+				left += right - m;
+			});
+			return bounds.size() > 1 ? *mid[0].value : 0;
+		}
+
+		// Удаляет элементы по pred внутри кусков параллельно (std::remove_if),
+		// затем сдвигает уцелевшие префиксы кусков влево одним проходом.
+		// Возвращает новый размер
+		template <typename T, typename Pred>
+		std::size_t remove_if(T *first, std::size_t n, Pred pred, Options opt = {})
+		{
+			ThreadPool &pool = detail::pool_of(opt);
+			auto bounds = detail::split(first, n, opt.grain, pool.size() + 1);
+			Vector<detail::Padded<std::size_t>> kept(bounds.size());
+			auto body = [first, &pred, &kept](std::size_t b, std::size_t e, std::size_t c) {
+				kept[c].value = std::remove_if(first + b, first + e, pred) - first;
+			};
+			detail::run_chunks(pool, bounds, body);
+
+			std::size_t out = bounds.size() > 1 ? *kept[0].value : 0;
+			for (std::size_t c = 1; c + 1 < bounds.size(); ++c)
+			{
+				std::size_t b = bounds[c], e = *kept[c].value;
+				if (out != b)
+					std::move(first + b, first + e, first + out);
+				out += e - b;
+			}
+			return out;
+		}
+
+		// Перегрузки для Vector: работают с data()/size()
+
+		template <typename T, typename A, typename G, typename S, typename F>
+		void for_each(Vector<T, A, G, S> &v, F f, Options opt = {})
+		{
+			for_each(v.data(), v.size(), std::move(f), opt);
+		}
+
+		// Размер out подгоняется под in без value-инициализации
+		template <typename T, typename A, typename G, typename S, typename U, typename B, typename H, typename K, typename F>
+		void transform(const Vector<T, A, G, S> &in, Vector<U, B, H, K> &out, F f, Options opt = {})
+		{
+			out.resize_default_init(in.size());
+			transform(in.data(), in.size(), out.data(), std::move(f), opt);
+		}
+
+		template <typename T, typename A, typename G, typename S, typename R, typename Op = std::plus<>>
+		R reduce(const Vector<T, A, G, S> &v, R init, Op op = Op(), Options opt = {})
+		{
+			return reduce(v.data(), v.size(), std::move(init), std::move(op), opt);
+		}
+
+		template <typename T, typename A, typename G, typename S, typename Compare = std::less<>>
+		void sort(Vector<T, A, G, S> &v, Compare comp = Compare(), Options opt = {})
+		{
+			sort(v.data(), v.size(), std::move(comp), opt);
+		}
+
+		// Возвращает итератор на первый элемент, не удовлетворяющий pred
+		template <typename T, typename A, typename G, typename S, typename Pred>
+		typename Vector<T, A, G, S>::iterator stable_partition(Vector<T, A, G, S> &v, Pred pred, Options opt = {})
+		{
+			return v.begin() + stable_partition(v.data(), v.size(), std::move(pred), opt);
+		}
+
+		// Возвращает число удалённых элементов
+		template <typename T, typename A, typename G, typename S, typename Pred>
+		std::size_t erase_if(Vector<T, A, G, S> &v, Pred pred, Options opt = {})
+		{
+			std::size_t n = v.size();
+			std::size_t kept = remove_if(v.data(), n, std::move(pred), opt);
+			v.erase(v.begin() + kept, v.end());
+			return n - kept;
+		}
+	}
+}
@@ -0,0 +1,299 @@
+#pragma once
+
+#include "Vector.h"
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+namespace miv
+{
+	// Бинарный снимок вектора:
+	//   заголовок (24 байта, порядок байт писавшей машины)
+	//   кадры: uint32 длина в байтах + данные (целое число элементов)
+	//   кадр нулевой длины - конец потока
+	// Кадры ограничены chunk_bytes, поэтому снимок любого размера пишется и
+	// читается с буфером фиксированного размера (или прямо в data()).
+	struct Snapshot_error : std::runtime_error
+	{
+		using std::runtime_error::runtime_error;
+	};
+
+	enum class SnapshotKind : std::uint8_t
+	{
+		elements = 0, // массив T
+		bits = 1,	  // Vector<bool>: 64-битные слова, count - число бит
+	};
+
+	struct SnapshotHeader
+	{
+		char magic[4];
+		std::uint16_t version;
+		std::uint8_t endian; // 1 - little, 2 - big
+		std::uint8_t kind;
+		std::uint32_t elem_size;
+		std::uint32_t chunk_bytes; // максимальная длина кадра
+		std::uint64_t count;
+	};
+	static_assert(sizeof(SnapshotHeader) == 24, "SnapshotHeader must have no padding");
+
+	namespace detail
+	{
+		inline constexpr char snapshot_magic[4] = { 'M', 'I', 'V', 'S' };
+		inline constexpr std::uint16_t snapshot_version = 1;
+		inline constexpr std::size_t default_chunk_bytes = std::size_t(1) << 20;
+
+		inline std::uint8_t native_endian() noexcept
+		{
+			const std::uint16_t probe = 1;
+			unsigned char first;
+			std::memcpy(&first, &probe, 1);
+			return first ? 1 : 2;
+		}
+
+		template <typename U>
+		U byteswap(U v) noexcept
+		{
+			static_assert(std::is_unsigned_v<U>);
+			if constexpr (sizeof(U) == 1)
+				return v;
+			else if constexpr (sizeof(U) == 2)
+				return static_cast<U>(__builtin_bswap16(v));
+			else if constexpr (sizeof(U) == 4)
+				return static_cast<U>(__builtin_bswap32(v));
+			else
+				return static_cast<U>(__builtin_bswap64(v));
+		}
+
+		// Разворот байт каждого из n элементов размера size
+		inline void byteswap_elements(void *data, std::size_t n, std::size_t size) noexcept
+		{
+			unsigned char *p = static_cast<unsigned char *>(data);
+			for (std::size_t i = 0; i < n; ++i, p += size)
+				std::reverse(p, p + size);
+		}
+	}
+
+	// Потоковая запись снимка: заголовок пишется в конструкторе, данные -
+	// любыми порциями через write(), finish() закрывает поток кадров.
+	template <typename T>
+	class SnapshotWriter
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "snapshots require a trivially copyable T");
+
+	public:
+		// count - сколько элементов (для bits - бит) будет записано
+		SnapshotWriter(std::ostream &os, std::uint64_t count,
+					   SnapshotKind kind = SnapshotKind::elements,
+					   std::size_t chunk_bytes = detail::default_chunk_bytes)
+			: os_(os), count_(count), units_(kind == SnapshotKind::bits ? (count + 63) / 64 : count), written_(0),
+			  chunk_elems_(std::max<std::size_t>(chunk_bytes / sizeof(T), 1))
+		{
+			if (chunk_elems_ * sizeof(T) > std::numeric_limits<std::uint32_t>::max())
+				chunk_elems_ = std::numeric_limits<std::uint32_t>::max() / sizeof(T);
+			SnapshotHeader h;
+			std::memcpy(h.magic, detail::snapshot_magic, 4);
+			h.version = detail::snapshot_version;
+			h.endian = detail::native_endian();
+			h.kind = static_cast<std::uint8_t>(kind);
+			h.elem_size = static_cast<std::uint32_t>(sizeof(T));
+			h.chunk_bytes = static_cast<std::uint32_t>(chunk_elems_ * sizeof(T));
+			h.count = count_;
+			put(&h, sizeof(h));
+		}
+
+		// Данные уходят в поток напрямую из p, кадрами не длиннее chunk_bytes
+		void write(const T *p, std::size_t n)
+		{
+			if (n > units_ - written_)
+				throw Snapshot_error("snapshot: more data than declared in the header");
+			while (n)
+			{
+				std::size_t k = std::min(n, chunk_elems_);
+				std::uint32_t len = static_cast<std::uint32_t>(k * sizeof(T));
+				put(&len, sizeof(len));
+				put(p, len);
+				p += k;
+				n -= k;
+				written_ += k;
+			}
+		}
+
+		void finish()
+		{
+			if (written_ != units_)
+				throw Snapshot_error("snapshot: less data than declared in the header");
+			std::uint32_t end = 0;
+			put(&end, sizeof(end));
+			os_.flush();
+			if (!os_)
+				throw Snapshot_error("snapshot: write failed");
+		}
+
+	private:
+		std::ostream &os_;
+		std::uint64_t count_, units_, written_;
+		std::size_t chunk_elems_;
+
+		void put(const void *p, std::size_t bytes)
+		{
+			if (!os_.write(static_cast<const char *>(p), static_cast<std::streamsize>(bytes)))
+				throw Snapshot_error("snapshot: write failed");
+		}
+	};
+
+	// Потоковое чтение снимка: read() отдаёт элементы порциями в буфер
+	// вызывающего и возвращает 0 в конце. Если снимок записан машиной с другим
+	// порядком байт, арифметические T разворачиваются на месте.
+	template <typename T>
+	class SnapshotReader
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "snapshots require a trivially copyable T");
+
+	public:
+		explicit SnapshotReader(std::istream &is, SnapshotKind kind = SnapshotKind::elements)
+			: is_(is), frame_left_(0), done_(false)
+		{
+			get(&h_, sizeof(h_));
+			if (std::memcmp(h_.magic, detail::snapshot_magic, 4) != 0)
+				throw Snapshot_error("snapshot: bad magic");
+			if (h_.endian != 1 && h_.endian != 2)
+				throw Snapshot_error("snapshot: bad endianness tag");
+			swap_ = h_.endian != detail::native_endian();
+			if (swap_)
+			{
+				h_.version = detail::byteswap(h_.version);
+				h_.elem_size = detail::byteswap(h_.elem_size);
+				h_.chunk_bytes = detail::byteswap(h_.chunk_bytes);
+				h_.count = detail::byteswap(h_.count);
+			}
+			if (h_.version == 0 || h_.version > detail::snapshot_version)
+				throw Snapshot_error("snapshot: unsupported version " + std::to_string(h_.version));
+			if (h_.kind != static_cast<std::uint8_t>(kind))
+				throw Snapshot_error("snapshot: kind mismatch");
+			if (h_.elem_size != sizeof(T))
+				throw Snapshot_error("snapshot: element size " + std::to_string(h_.elem_size) +
+									 ", expected " + std::to_string(sizeof(T)));
+			if (swap_ && !std::is_arithmetic_v<T> && !std::is_enum_v<T>)
+				throw Snapshot_error("snapshot: byte order differs and T is not arithmetic");
+			units_left_ = kind == SnapshotKind::bits ? (h_.count + 63) / 64 : h_.count;
+		}
+
+		const SnapshotHeader &header() const noexcept { return h_; }
+		std::uint64_t count() const noexcept { return h_.count; }
+
+		// До n элементов в out; 0 - данные закончились
+		std::size_t read(T *out, std::size_t n)
+		{
+			std::size_t total = 0;
+			while (total < n && !done_)
+			{
+				if (frame_left_ == 0 && !next_frame())
+					break;
+				std::size_t k = std::min<std::size_t>(n - total, frame_left_ / sizeof(T));
+				get(out + total, k * sizeof(T));
+				if (swap_)
+					detail::byteswap_elements(out + total, k, sizeof(T));
+				frame_left_ -= k * sizeof(T);
+				units_left_ -= k;
+				total += k;
+			}
+			return total;
+		}
+
+		// Проверить, что все данные прочитаны и поток завершён кадром нулевой длины
+		void finish()
+		{
+			if (!done_ && (frame_left_ != 0 || next_frame()))
+				throw Snapshot_error("snapshot: more data than declared in the header");
+		}
+
+	private:
+		std::istream &is_;
+		SnapshotHeader h_;
+		std::uint64_t units_left_;
+		std::size_t frame_left_;
+		bool swap_, done_;
+
+		void get(void *p, std::size_t bytes)
+		{
+			if (!is_.read(static_cast<char *>(p), static_cast<std::streamsize>(bytes)))
+				throw Snapshot_error("snapshot: unexpected end of stream");
+		}
+
+		bool next_frame()
+		{
+			std::uint32_t len;
+			get(&len, sizeof(len));
+			if (swap_)
+				len = detail::byteswap(len);
+			if (len == 0)
+			{
+				if (units_left_ != 0)
+					throw Snapshot_error("snapshot: stream ended before all elements were read");
+				done_ = true;
+				return false;
+			}
+			if (len % sizeof(T) != 0 || len > h_.chunk_bytes || len / sizeof(T) > units_left_)
+				throw Snapshot_error("snapshot: corrupt frame");
+			frame_left_ = len;
+			return true;
+		}
+	};
+
+	// Снимок Vector<T> одним проходом по data()
+	template <typename T, typename A, typename G, typename S>
+	void save(std::ostream &os, const Vector<T, A, G, S> &v, std::size_t chunk_bytes = detail::default_chunk_bytes)
+	{
+		SnapshotWriter<T> w(os, v.size(), SnapshotKind::elements, chunk_bytes);
+		w.write(v.data(), v.size());
+		w.finish();
+	}
+
+	// Чтение в заранее выделенный буфер без value-инициализации элементов
+	template <typename T, typename A, typename G, typename S>
+	void load(std::istream &is, Vector<T, A, G, S> &v)
+	{
+		SnapshotReader<T> r(is);
+		if (r.count() > v.max_size())
+			throw Snapshot_error("snapshot: too many elements");
+		std::size_t n = static_cast<std::size_t>(r.count());
+		v.clear();
+		v.resize_default_init(n);
+		std::size_t got = 0;
+		while (got < n)
+			got += r.read(v.data() + got, n - got);
+		r.finish();
+	}
+
+	// Vector<bool>: упакованные 64-битные слова как есть
+	template <typename A, typename G, typename S>
+	void save(std::ostream &os, const Vector<bool, A, G, S> &v, std::size_t chunk_bytes = detail::default_chunk_bytes)
+	{
+		using word_type = typename Vector<bool, A, G, S>::word_type;
+		SnapshotWriter<word_type> w(os, v.size(), SnapshotKind::bits, chunk_bytes);
+		w.write(v.data(), v.num_words());
+		w.finish();
+	}
+
+	template <typename A, typename G, typename S>
+	void load(std::istream &is, Vector<bool, A, G, S> &v)
+	{
+		using word_type = typename Vector<bool, A, G, S>::word_type;
+		SnapshotReader<word_type> r(is, SnapshotKind::bits);
+		if (r.count() > std::numeric_limits<std::size_t>::max() - Vector<bool, A, G, S>::word_bits)
+			throw Snapshot_error("snapshot: too many bits");
+		bool indexed = v.has_index();
+		v.drop_index();
+		v.clear();
+		v.resize(static_cast<std::size_t>(r.count()));
+		std::size_t words = v.num_words(), got = 0;
+		while (got < words)
+			got += r.read(v.data() + got, words - got);
+		r.finish();
+		// хвост последнего слова обязан быть нулевым (инвариант Vector<bool>)
+		if (std::size_t tail = v.size() % Vector<bool, A, G, S>::word_bits)
+			v.data()[words - 1] &= (word_type(1) << tail) - 1;
+		if (indexed)
+			v.build_index();
+	}
+}
@@ -0,0 +1,839 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include "Vector.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+// GCC 12 ложно предупреждает о _mm512_undefined_* внутри AVX-512 интринсиков
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#define MIV_SIMD_X86 1
+#define MIV_SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MIV_SIMD_INLINE __attribute__((always_inline)) inline
+#else
+#define MIV_SIMD_INLINE inline
+#endif
+
+// Поиск и свёртки по непрерывным массивам арифметических T с выбором набора
+// инструкций во время выполнения: AVX-512 -> AVX2 -> SSE2 -> скаляр.
+// Векторные ядра есть для int32_t, float и double, остальные T идут
+// скалярным путём. Всё работает поверх data()/size(), для Vector есть
+// перегрузки.
+//
+// Семантика совпадает со скалярной версией:
+//   find/count/contains_any - operator== (NaN не находится, -0.0 == 0.0);
+//   min/max                 - NaN пропускаются;
+//   sum/dot                 - int32 копится в int64, float в double; для
+//                             плавающих порядок сложения другой, результат
+//                             может отличаться в последних битах.
+namespace miv
+{
+	namespace simd
+	{
+		enum class Isa : std::uint8_t
+		{
+			scalar = 0,
+			sse2 = 1,
+			avx2 = 2,
+			avx512 = 3
+		};
+
+		inline const char *isa_name(Isa isa) noexcept
+		{
+			switch (isa)
+			{
+			case Isa::sse2:
+				return "sse2";
+			case Isa::avx2:
+				return "avx2";
+			case Isa::avx512:
+				return "avx512";
+			default:
+				return "scalar";
+			}
+		}
+
+		// Лучший набор, который поддерживают процессор и ОС
+		inline Isa detected() noexcept
+		{
+#ifdef MIV_SIMD_X86
+			static const Isa isa = [] {
+				__builtin_cpu_init();
+				if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") &&
+					__builtin_cpu_supports("popcnt"))
+					return Isa::avx512;
+				if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+					return Isa::avx2;
+				if (__builtin_cpu_supports("sse2"))
+					return Isa::sse2;
+				return Isa::scalar;
+			}();
+			return isa;
+#else
+			return Isa::scalar;
+#endif
+		}
+
+		namespace detail
+		{
+			inline std::atomic<Isa> &active_isa() noexcept
+			{
+				static std::atomic<Isa> isa{ detected() };
+				return isa;
+			}
+		}
+
+		inline Isa active() noexcept
+		{
+			return detail::active_isa().load(std::memory_order_relaxed);
+		}
+
+		// Ограничить набор сверху (тесты, бенчмарки); выше detected() не поднимается
+		inline Isa set_isa(Isa isa) noexcept
+		{
+			Isa best = detected();
+			if (isa > best)
+				isa = best;
+			detail::active_isa().store(isa, std::memory_order_relaxed);
+			return isa;
+		}
+
+		// Тип суммы и скалярного произведения
+		template <typename T>
+		using sum_t = std::conditional_t<std::is_floating_point_v<T>, std::common_type_t<T, double>,
+										 std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+		namespace detail
+		{
+			template <typename T>
+			struct identity
+			{
+				using type = T;
+			};
+			template <typename T>
+			using identity_t = typename identity<T>::type;
+
+			// Vector<bool> хранит биты в словах: data() не массив T
+			template <typename T>
+			using if_elements_t = std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>;
+
+			template <typename T>
+			inline constexpr bool vector_type_v =
+				std::is_same_v<T, std::int32_t> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+			// Начальные значения min/max: NaN в сравнении x < m всегда проигрывает
+			template <typename T>
+			constexpr T min_init() noexcept
+			{
+				if constexpr (std::numeric_limits<T>::has_infinity)
+					return std::numeric_limits<T>::infinity();
+				else
+					return std::numeric_limits<T>::max();
+			}
+			template <typename T>
+			constexpr T max_init() noexcept
+			{
+				if constexpr (std::numeric_limits<T>::has_infinity)
+					return -std::numeric_limits<T>::infinity();
+				else
+					return std::numeric_limits<T>::lowest();
+			}
+
+#ifdef MIV_SIMD_X86
+			// Полосы: один регистр и операции над ним для пары (набор, T).
+			//   eq(a, b)      - маска равенства, бит на полосу
+			//   min/max(x, m) - x < m ? x : m (и наоборот), как minps/maxps
+			//   add(s, x)     - s + x с расширением в тип суммы
+			//   fma(s, a, b)  - s + a * b с расширением
+			template <typename T>
+			struct Sse2;
+			template <typename T>
+			struct Avx2;
+			template <typename T>
+			struct Avx512;
+
+#define MIV_SSE2 MIV_SIMD_TARGET("sse2")
+#define MIV_AVX2 MIV_SIMD_TARGET("avx2,popcnt")
+#define MIV_AVX512 MIV_SIMD_TARGET("avx512f,avx2,popcnt")
+
+			template <>
+			struct Sse2<std::int32_t>
+			{
+				using reg = __m128i;
+				using acc = __m128i;
+				static constexpr std::size_t lanes = 4, acc_lanes = 2;
+
+				MIV_SSE2 static reg load(const std::int32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+				MIV_SSE2 static reg set1(std::int32_t v) { return _mm_set1_epi32(v); }
+				MIV_SSE2 static void store(std::int32_t *p, reg x) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), x); }
+				MIV_SSE2 static std::uint64_t eq(reg a, reg b)
+				{
+					return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+				}
+				// pminsd/pmaxsd появились только в SSE4.1
+				MIV_SSE2 static reg min(reg x, reg m)
+				{
+					reg lt = _mm_cmplt_epi32(x, m);
+					return _mm_or_si128(_mm_and_si128(lt, x), _mm_andnot_si128(lt, m));
+				}
+				MIV_SSE2 static reg max(reg x, reg m)
+				{
+					reg gt = _mm_cmpgt_epi32(x, m);
+					return _mm_or_si128(_mm_and_si128(gt, x), _mm_andnot_si128(gt, m));
+				}
+				MIV_SSE2 static acc zero() { return _mm_setzero_si128(); }
+				MIV_SSE2 static void store(std::int64_t *p, acc s) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), s); }
+				MIV_SSE2 static acc add(acc s, reg x)
+				{
+					reg sign = _mm_srai_epi32(x, 31);
+					return _mm_add_epi64(s, _mm_add_epi64(_mm_unpacklo_epi32(x, sign), _mm_unpackhi_epi32(x, sign)));
+				}
+				// Знаковое 32x32->64 в чётных полосах через беззнаковое pmuludq:
+				// a*b = ua*ub - 2^32 * ((a < 0 ? ub : 0) + (b < 0 ? ua : 0))
+				MIV_SSE2 static acc mul_even(reg a, reg b)
+				{
+					reg fix = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b), _mm_and_si128(_mm_srai_epi32(b, 31), a));
+					return _mm_sub_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(fix, 32));
+				}
+				MIV_SSE2 static acc fma(acc s, reg a, reg b)
+				{
+					acc odd = mul_even(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+					return _mm_add_epi64(s, _mm_add_epi64(mul_even(a, b), odd));
+				}
+			};
+
+			template <>
+			struct Sse2<float>
+			{
+				using reg = __m128;
+				using acc = __m128d;
+				static constexpr std::size_t lanes = 4, acc_lanes = 2;
+
+				MIV_SSE2 static reg load(const float *p) { return _mm_loadu_ps(p); }
+				MIV_SSE2 static reg set1(float v) { return _mm_set1_ps(v); }
+				MIV_SSE2 static void store(float *p, reg x) { _mm_storeu_ps(p, x); }
+				MIV_SSE2 static std::uint64_t eq(reg a, reg b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+				MIV_SSE2 static reg min(reg x, reg m) { return _mm_min_ps(x, m); }
+				MIV_SSE2 static reg max(reg x, reg m) { return _mm_max_ps(x, m); }
+				MIV_SSE2 static acc zero() { return _mm_setzero_pd(); }
+				MIV_SSE2 static void store(double *p, acc s) { _mm_storeu_pd(p, s); }
+				MIV_SSE2 static acc add(acc s, reg x)
+				{
+					return _mm_add_pd(s, _mm_add_pd(_mm_cvtps_pd(x), _mm_cvtps_pd(_mm_movehl_ps(x, x))));
+				}
+				MIV_SSE2 static acc fma(acc s, reg a, reg b)
+				{
+					acc lo = _mm_mul_pd(_mm_cvtps_pd(a), _mm_cvtps_pd(b));
+					acc hi = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), _mm_cvtps_pd(_mm_movehl_ps(b, b)));
+					return _mm_add_pd(s, _mm_add_pd(lo, hi));
+				}
+			};
+
+			template <>
+			struct Sse2<double>
+			{
+				using reg = __m128d;
+				using acc = __m128d;
+				static constexpr std::size_t lanes = 2, acc_lanes = 2;
+
+				MIV_SSE2 static reg load(const double *p) { return _mm_loadu_pd(p); }
+				MIV_SSE2 static reg set1(double v) { return _mm_set1_pd(v); }
+				MIV_SSE2 static void store(double *p, reg x) { _mm_storeu_pd(p, x); }
+				MIV_SSE2 static std::uint64_t eq(reg a, reg b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+				MIV_SSE2 static reg min(reg x, reg m) { return _mm_min_pd(x, m); }
+				MIV_SSE2 static reg max(reg x, reg m) { return _mm_max_pd(x, m); }
+				MIV_SSE2 static acc zero() { return _mm_setzero_pd(); }
+				MIV_SSE2 static acc add(acc s, reg x) { return _mm_add_pd(s, x); }
+				MIV_SSE2 static acc fma(acc s, reg a, reg b) { return _mm_add_pd(s, _mm_mul_pd(a, b)); }
+			};
+
+			template <>
+			struct Avx2<std::int32_t>
+			{
+				using reg = __m256i;
+				using acc = __m256i;
+				static constexpr std::size_t lanes = 8, acc_lanes = 4;
+
+				MIV_AVX2 static reg load(const std::int32_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+				MIV_AVX2 static reg set1(std::int32_t v) { return _mm256_set1_epi32(v); }
+				MIV_AVX2 static void store(std::int32_t *p, reg x) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x); }
+				MIV_AVX2 static std::uint64_t eq(reg a, reg b)
+				{
+					return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+				}
+				MIV_AVX2 static reg min(reg x, reg m) { return _mm256_min_epi32(x, m); }
+				MIV_AVX2 static reg max(reg x, reg m) { return _mm256_max_epi32(x, m); }
+				MIV_AVX2 static acc zero() { return _mm256_setzero_si256(); }
+				MIV_AVX2 static void store(std::int64_t *p, acc s) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), s); }
+				MIV_AVX2 static acc add(acc s, reg x)
+				{
+					acc lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x));
+					acc hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1));
+					return _mm256_add_epi64(s, _mm256_add_epi64(lo, hi));
+				}
+				MIV_AVX2 static acc fma(acc s, reg a, reg b)
+				{
+					acc even = _mm256_mul_epi32(a, b);
+					acc odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+					return _mm256_add_epi64(s, _mm256_add_epi64(even, odd));
+				}
+			};
+
+			template <>
+			struct Avx2<float>
+			{
+				using reg = __m256;
+				using acc = __m256d;
+				static constexpr std::size_t lanes = 8, acc_lanes = 4;
+
+				MIV_AVX2 static reg load(const float *p) { return _mm256_loadu_ps(p); }
+				MIV_AVX2 static reg set1(float v) { return _mm256_set1_ps(v); }
+				MIV_AVX2 static void store(float *p, reg x) { _mm256_storeu_ps(p, x); }
+				MIV_AVX2 static std::uint64_t eq(reg a, reg b)
+				{
+					return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+				}
+				MIV_AVX2 static reg min(reg x, reg m) { return _mm256_min_ps(x, m); }
+				MIV_AVX2 static reg max(reg x, reg m) { return _mm256_max_ps(x, m); }
+				MIV_AVX2 static acc zero() { return _mm256_setzero_pd(); }
+				MIV_AVX2 static void store(double *p, acc s) { _mm256_storeu_pd(p, s); }
+				MIV_AVX2 static acc add(acc s, reg x)
+				{
+					acc lo = _mm256_cvtps_pd(_mm256_castps256_ps128(x));
+					acc hi = _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1));
+					return _mm256_add_pd(s, _mm256_add_pd(lo, hi));
+				}
+				MIV_AVX2 static acc fma(acc s, reg a, reg b)
+				{
+					acc lo = _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(a)), _mm256_cvtps_pd(_mm256_castps256_ps128(b)));
+					acc hi = _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)), _mm256_cvtps_pd(_mm256_extractf128_ps(b, 1)));
+					return _mm256_add_pd(s, _mm256_add_pd(lo, hi));
+				}
+			};
+
+			template <>
+			struct Avx2<double>
+			{
+				using reg = __m256d;
+				using acc = __m256d;
+				static constexpr std::size_t lanes = 4, acc_lanes = 4;
+
+				MIV_AVX2 static reg load(const double *p) { return _mm256_loadu_pd(p); }
+				MIV_AVX2 static reg set1(double v) { return _mm256_set1_pd(v); }
+				MIV_AVX2 static void store(double *p, reg x) { _mm256_storeu_pd(p, x); }
+				MIV_AVX2 static std::uint64_t eq(reg a, reg b)
+				{
+					return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+				}
+				MIV_AVX2 static reg min(reg x, reg m) { return _mm256_min_pd(x, m); }
+				MIV_AVX2 static reg max(reg x, reg m) { return _mm256_max_pd(x, m); }
+				MIV_AVX2 static acc zero() { return _mm256_setzero_pd(); }
+				MIV_AVX2 static acc add(acc s, reg x) { return _mm256_add_pd(s, x); }
+				MIV_AVX2 static acc fma(acc s, reg a, reg b) { return _mm256_add_pd(s, _mm256_mul_pd(a, b)); }
+			};
+
+			// Только AVX-512F: половины регистра достаются через extractf64x4
+			// (extractf32x8 требует DQ, а _mm512_cast*512_*256 в GCC 12 даёт
+			// ложные -Wmaybe-uninitialized)
+			template <>
+			struct Avx512<std::int32_t>
+			{
+				using reg = __m512i;
+				using acc = __m512i;
+				static constexpr std::size_t lanes = 16, acc_lanes = 8;
+
+				MIV_AVX512 static reg load(const std::int32_t *p) { return _mm512_loadu_si512(p); }
+				MIV_AVX512 static reg set1(std::int32_t v) { return _mm512_set1_epi32(v); }
+				MIV_AVX512 static void store(std::int32_t *p, reg x) { _mm512_storeu_si512(p, x); }
+				MIV_AVX512 static std::uint64_t eq(reg a, reg b) { return _mm512_cmpeq_epi32_mask(a, b); }
+				MIV_AVX512 static reg min(reg x, reg m) { return _mm512_min_epi32(x, m); }
+				MIV_AVX512 static reg max(reg x, reg m) { return _mm512_max_epi32(x, m); }
+				MIV_AVX512 static acc zero() { return _mm512_setzero_si512(); }
+				MIV_AVX512 static void store(std::int64_t *p, acc s) { _mm512_storeu_si512(p, s); }
+				MIV_AVX512 static acc add(acc s, reg x)
+				{
+					// чётные и нечётные полосы с расширением знака
+					acc even = _mm512_srai_epi64(_mm512_slli_epi64(x, 32), 32);
+					return _mm512_add_epi64(s, _mm512_add_epi64(even, _mm512_srai_epi64(x, 32)));
+				}
+				MIV_AVX512 static acc fma(acc s, reg a, reg b)
+				{
+					acc even = _mm512_mul_epi32(a, b);
+					acc odd = _mm512_mul_epi32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+					return _mm512_add_epi64(s, _mm512_add_epi64(even, odd));
+				}
+			};
+
+			template <>
+			struct Avx512<float>
+			{
+				using reg = __m512;
+				using acc = __m512d;
+				static constexpr std::size_t lanes = 16, acc_lanes = 8;
+
+				MIV_AVX512 static reg load(const float *p) { return _mm512_loadu_ps(p); }
+				MIV_AVX512 static reg set1(float v) { return _mm512_set1_ps(v); }
+				MIV_AVX512 static void store(float *p, reg x) { _mm512_storeu_ps(p, x); }
+				MIV_AVX512 static std::uint64_t eq(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+				MIV_AVX512 static reg min(reg x, reg m) { return _mm512_min_ps(x, m); }
+				MIV_AVX512 static reg max(reg x, reg m) { return _mm512_max_ps(x, m); }
+				MIV_AVX512 static acc zero() { return _mm512_setzero_pd(); }
+				MIV_AVX512 static void store(double *p, acc s) { _mm512_storeu_pd(p, s); }
+				template <int I>
+				MIV_AVX512 static acc half(reg x)
+				{
+					return _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x), I)));
+				}
+				MIV_AVX512 static acc add(acc s, reg x) { return _mm512_add_pd(s, _mm512_add_pd(half<0>(x), half<1>(x))); }
+				MIV_AVX512 static acc fma(acc s, reg a, reg b)
+				{
+					acc lo = _mm512_mul_pd(half<0>(a), half<0>(b));
+					acc hi = _mm512_mul_pd(half<1>(a), half<1>(b));
+					return _mm512_add_pd(s, _mm512_add_pd(lo, hi));
+				}
+			};
+
+			template <>
+			struct Avx512<double>
+			{
+				using reg = __m512d;
+				using acc = __m512d;
+				static constexpr std::size_t lanes = 8, acc_lanes = 8;
+
+				MIV_AVX512 static reg load(const double *p) { return _mm512_loadu_pd(p); }
+				MIV_AVX512 static reg set1(double v) { return _mm512_set1_pd(v); }
+				MIV_AVX512 static void store(double *p, reg x) { _mm512_storeu_pd(p, x); }
+				MIV_AVX512 static std::uint64_t eq(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+				MIV_AVX512 static reg min(reg x, reg m) { return _mm512_min_pd(x, m); }
+				MIV_AVX512 static reg max(reg x, reg m) { return _mm512_max_pd(x, m); }
+				MIV_AVX512 static acc zero() { return _mm512_setzero_pd(); }
+				MIV_AVX512 static acc add(acc s, reg x) { return _mm512_add_pd(s, x); }
+				MIV_AVX512 static acc fma(acc s, reg a, reg b) { return _mm512_add_pd(s, _mm512_mul_pd(a, b)); }
+			};
+#endif
+
+			// Ядра пишутся один раз поверх полос L и встраиваются в точки
+			// входа run_* с нужным target; сами по себе они не компилируются
+			// под AVX, отсюда и ложные предупреждения об ABI
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+			struct FindOp
+			{
+				// Четыре регистра на итерацию, маски склеиваются в одно слово
+				template <typename L, typename T>
+				MIV_SIMD_INLINE static std::size_t run(const T *p, std::size_t n, T value)
+				{
+					constexpr std::size_t W = L::lanes;
+					auto needle = L::set1(value);
+					std::size_t i = 0;
+					for (; i + 4 * W <= n; i += 4 * W)
+					{
+						std::uint64_t m = L::eq(L::load(p + i), needle) | L::eq(L::load(p + i + W), needle) << W |
+										  L::eq(L::load(p + i + 2 * W), needle) << 2 * W |
+										  L::eq(L::load(p + i + 3 * W), needle) << 3 * W;
+						if (m)
+							return i + miv::detail::ctz64(m);
+					}
+					for (; i + W <= n; i += W)
+					{
+						std::uint64_t m = L::eq(L::load(p + i), needle);
+						if (m)
+							return i + miv::detail::ctz64(m);
+					}
+					return i + scalar(p + i, n - i, value);
+				}
+
+				template <typename T>
+				static std::size_t scalar(const T *p, std::size_t n, T value) noexcept
+				{
+					for (std::size_t i = 0; i < n; ++i)
+						if (p[i] == value)
+							return i;
+					return n;
+				}
+			};
+
+			struct CountOp
+			{
+				template <typename L, typename T>
+				MIV_SIMD_INLINE static std::size_t run(const T *p, std::size_t n, T value)
+				{
+					constexpr std::size_t W = L::lanes;
+					auto needle = L::set1(value);
+					std::size_t c = 0, i = 0;
+					for (; i + 4 * W <= n; i += 4 * W)
+						c += miv::detail::popcount64(L::eq(L::load(p + i), needle) | L::eq(L::load(p + i + W), needle) << W |
+													 L::eq(L::load(p + i + 2 * W), needle) << 2 * W |
+													 L::eq(L::load(p + i + 3 * W), needle) << 3 * W);
+					for (; i + W <= n; i += W)
+						c += miv::detail::popcount64(L::eq(L::load(p + i), needle));
+					return c + scalar(p + i, n - i, value);
+				}
+
+				template <typename T>
+				static std::size_t scalar(const T *p, std::size_t n, T value) noexcept
+				{
+					std::size_t c = 0;
+					for (std::size_t i = 0; i < n; ++i)
+						c += p[i] == value;
+					return c;
+				}
+			};
+
+			// Min/Max - какие из концов нужны; два аккумулятора на каждый
+			template <bool Min, bool Max>
+			struct ExtremeOp
+			{
+				template <typename L, typename T>
+				MIV_SIMD_INLINE static std::pair<T, T> run(const T *p, std::size_t n)
+				{
+					constexpr std::size_t W = L::lanes;
+					auto lo0 = L::set1(min_init<T>()), lo1 = lo0;
+					auto hi0 = L::set1(max_init<T>()), hi1 = hi0;
+					std::size_t i = 0;
+					for (; i + 2 * W <= n; i += 2 * W)
+					{
+						auto x0 = L::load(p + i), x1 = L::load(p + i + W);
+						if constexpr (Min)
+							lo0 = L::min(x0, lo0), lo1 = L::min(x1, lo1);
+						if constexpr (Max)
+							hi0 = L::max(x0, hi0), hi1 = L::max(x1, hi1);
+					}
+					for (; i + W <= n; i += W)
+					{
+						auto x = L::load(p + i);
+						if constexpr (Min)
+							lo0 = L::min(x, lo0);
+						if constexpr (Max)
+							hi0 = L::max(x, hi0);
+					}
+					T lo[W], hi[W];
+					L::store(lo, L::min(lo1, lo0));
+					L::store(hi, L::max(hi1, hi0));
+					std::pair<T, T> r = scalar(lo, W);
+					std::pair<T, T> h = scalar(hi, W);
+					std::pair<T, T> t = scalar(p + i, n - i);
+					r.second = h.second;
+					r.first = t.first < r.first ? t.first : r.first;
+					r.second = t.second > r.second ? t.second : r.second;
+					return r;
+				}
+
+				template <typename T>
+				static std::pair<T, T> scalar(const T *p, std::size_t n) noexcept
+				{
+					T lo = min_init<T>(), hi = max_init<T>();
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						lo = p[i] < lo ? p[i] : lo;
+						hi = p[i] > hi ? p[i] : hi;
+					}
+					return { lo, hi };
+				}
+			};
+
+			// Четыре независимых аккумулятора скрывают задержку сложения
+			struct SumOp
+			{
+				template <typename L, typename T>
+				MIV_SIMD_INLINE static sum_t<T> run(const T *p, std::size_t n)
+				{
+					constexpr std::size_t W = L::lanes;
+					typename L::acc s[4] = { L::zero(), L::zero(), L::zero(), L::zero() };
+					std::size_t i = 0;
+					for (; i + 4 * W <= n; i += 4 * W)
+					{
+						s[0] = L::add(s[0], L::load(p + i));
+						s[1] = L::add(s[1], L::load(p + i + W));
+						s[2] = L::add(s[2], L::load(p + i + 2 * W));
+						s[3] = L::add(s[3], L::load(p + i + 3 * W));
+					}
+					for (; i + W <= n; i += W)
+						s[0] = L::add(s[0], L::load(p + i));
+					return reduce<L, T>(s) + scalar(p + i, n - i);
+				}
+
+				template <typename L, typename T>
+				MIV_SIMD_INLINE static sum_t<T> reduce(const typename L::acc (&acc)[4])
+				{
+					sum_t<T> lanes[4][L::acc_lanes];
+					for (int k = 0; k < 4; ++k)
+						L::store(lanes[k], acc[k]);
+					sum_t<T> s = 0;
+					for (auto &row : lanes)
+						for (sum_t<T> x : row)
+							s += x;
+					return s;
+				}
+
+				template <typename T>
+				static sum_t<T> scalar(const T *p, std::size_t n) noexcept
+				{
+					sum_t<T> s = 0;
+					for (std::size_t i = 0; i < n; ++i)
+						s += static_cast<sum_t<T>>(p[i]);
+					return s;
+				}
+			};
+
+			struct DotOp
+			{
+				template <typename L, typename T>
+				MIV_SIMD_INLINE static sum_t<T> run(const T *a, const T *b, std::size_t n)
+				{
+					constexpr std::size_t W = L::lanes;
+					typename L::acc s[4] = { L::zero(), L::zero(), L::zero(), L::zero() };
+					std::size_t i = 0;
+					for (; i + 4 * W <= n; i += 4 * W)
+					{
+						s[0] = L::fma(s[0], L::load(a + i), L::load(b + i));
+						s[1] = L::fma(s[1], L::load(a + i + W), L::load(b + i + W));
+						s[2] = L::fma(s[2], L::load(a + i + 2 * W), L::load(b + i + 2 * W));
+						s[3] = L::fma(s[3], L::load(a + i + 3 * W), L::load(b + i + 3 * W));
+					}
+					for (; i + W <= n; i += W)
+						s[0] = L::fma(s[0], L::load(a + i), L::load(b + i));
+					return SumOp::reduce<L, T>(s) + scalar(a + i, b + i, n - i);
+				}
+
+				template <typename T>
+				static sum_t<T> scalar(const T *a, const T *b, std::size_t n) noexcept
+				{
+					sum_t<T> s = 0;
+					for (std::size_t i = 0; i < n; ++i)
+						s += static_cast<sum_t<T>>(a[i]) * static_cast<sum_t<T>>(b[i]);
+					return s;
+				}
+			};
+
+			// Искомые значения разбиваются на группы по 8 регистров;
+			// на каждую группу - один проход по данным
+			struct ContainsAnyOp
+			{
+				static constexpr std::size_t group = 8;
+
+				template <typename L, typename T>
+				MIV_SIMD_INLINE static bool run(const T *p, std::size_t n, const T *values, std::size_t m)
+				{
+					constexpr std::size_t W = L::lanes;
+					for (std::size_t k = 0; k < m; k += group)
+					{
+						std::size_t g = m - k < group ? m - k : group;
+						typename L::reg needles[group];
+						for (std::size_t j = 0; j < g; ++j)
+							needles[j] = L::set1(values[k + j]);
+						std::size_t i = 0;
+						for (; i + W <= n; i += W)
+						{
+							auto x = L::load(p + i);
+							std::uint64_t hit = 0;
+							for (std::size_t j = 0; j < g; ++j)
+								hit |= L::eq(x, needles[j]);
+							if (hit)
+								return true;
+						}
+						if (scalar(p + i, n - i, values + k, g))
+							return true;
+					}
+					return false;
+				}
+
+				template <typename T>
+				static bool scalar(const T *p, std::size_t n, const T *values, std::size_t m) noexcept
+				{
+					for (std::size_t i = 0; i < n; ++i)
+						for (std::size_t j = 0; j < m; ++j)
+							if (p[i] == values[j])
+								return true;
+					return false;
+				}
+			};
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#ifdef MIV_SIMD_X86
+			template <typename Op, typename L, typename... Args>
+			MIV_SSE2 auto run_sse2(Args... args)
+			{
+				return Op::template run<L>(args...);
+			}
+			template <typename Op, typename L, typename... Args>
+			MIV_AVX2 auto run_avx2(Args... args)
+			{
+				return Op::template run<L>(args...);
+			}
+			template <typename Op, typename L, typename... Args>
+			MIV_AVX512 auto run_avx512(Args... args)
+			{
+				return Op::template run<L>(args...);
+			}
+
+#undef MIV_SSE2
+#undef MIV_AVX2
+#undef MIV_AVX512
+#endif
+
+			template <typename Op, typename T, typename... Args>
+			auto dispatch(Args... args)
+			{
+#ifdef MIV_SIMD_X86
+				if constexpr (vector_type_v<T>)
+				{
+					switch (active())
+					{
+					case Isa::avx512:
+						return run_avx512<Op, Avx512<T>>(args...);
+					case Isa::avx2:
+						return run_avx2<Op, Avx2<T>>(args...);
+					case Isa::sse2:
+						return run_sse2<Op, Sse2<T>>(args...);
+					default:
+						break;
+					}
+				}
+#endif
+				return Op::scalar(args...);
+			}
+
+			[[noreturn]] inline void throw_empty(const char *what)
+			{
+				throw std::invalid_argument(std::string("simd::") + what + ": empty range");
+			}
+		}
+
+		// Индекс первого элемента, равного value; n, если такого нет
+		template <typename T>
+		std::size_t find(const T *p, std::size_t n, detail::identity_t<T> value) noexcept
+		{
+			return detail::dispatch<detail::FindOp, T>(p, n, value);
+		}
+
+		template <typename T>
+		std::size_t count(const T *p, std::size_t n, detail::identity_t<T> value) noexcept
+		{
+			return detail::dispatch<detail::CountOp, T>(p, n, value);
+		}
+
+		// На пустом диапазоне - std::invalid_argument
+		template <typename T>
+		T min(const T *p, std::size_t n)
+		{
+			if (n == 0)
+				detail::throw_empty("min");
+			return detail::dispatch<detail::ExtremeOp<true, false>, T>(p, n).first;
+		}
+
+		template <typename T>
+		T max(const T *p, std::size_t n)
+		{
+			if (n == 0)
+				detail::throw_empty("max");
+			return detail::dispatch<detail::ExtremeOp<false, true>, T>(p, n).second;
+		}
+
+		template <typename T>
+		std::pair<T, T> minmax(const T *p, std::size_t n)
+		{
+			if (n == 0)
+				detail::throw_empty("minmax");
+			return detail::dispatch<detail::ExtremeOp<true, true>, T>(p, n);
+		}
+
+		template <typename T>
+		sum_t<T> sum(const T *p, std::size_t n) noexcept
+		{
+			return detail::dispatch<detail::SumOp, T>(p, n);
+		}
+
+		template <typename T>
+		sum_t<T> dot(const T *a, const T *b, std::size_t n) noexcept
+		{
+			return detail::dispatch<detail::DotOp, T>(a, b, n);
+		}
+
+		// Есть ли в [p, p + n) хотя бы одно из m значений
+		template <typename T>
+		bool contains_any(const T *p, std::size_t n, const T *values, std::size_t m) noexcept
+		{
+			return detail::dispatch<detail::ContainsAnyOp, T>(p, n, values, m);
+		}
+
+		// Перегрузки для Vector: работают с data()/size(), только арифметические T
+		// (Vector<bool> в них не попадает)
+
+		template <typename T, typename A, typename G, typename S, typename = detail::if_elements_t<T>>
+		typename Vector<T, A, G, S>::const_iterator find(const Vector<T, A, G, S> &v, detail::identity_t<T> value) noexcept
+		{
+			return v.begin() + find(v.data(), v.size(), value);
+		}
+
+		template <typename T, typename A, typename G, typename S, typename = detail::if_elements_t<T>>
+		std::size_t count(const Vector<T, A, G, S> &v, detail::identity_t<T> value) noexcept
+		{
+			return count(v.data(), v.size(), value);
+		}
+
+		template <typename T, typename A, typename G, typename S, typename = detail::if_elements_t<T>>
+		T min(const Vector<T, A, G, S> &v)
+		{
+			return min(v.data(), v.size());
+		}
+
+		template <typename T, typename A, typename G, typename S, typename = detail::if_elements_t<T>>
+		T max(const Vector<T, A, G, S> &v)
+		{
+			return max(v.data(), v.size());
+		}
+
+		template <typename T, typename A, typename G, typename S, typename = detail::if_elements_t<T>>
+		std::pair<T, T> minmax(const Vector<T, A, G, S> &v)
+		{
+			return minmax(v.data(), v.size());
+		}
+
+		template <typename T, typename A, typename G, typename S, typename = detail::if_elements_t<T>>
+		sum_t<T> sum(const Vector<T, A, G, S> &v) noexcept
+		{
+			return sum(v.data(), v.size());
+		}
+
+		// Длина - меньший из размеров
+		template <typename T, typename A, typename G, typename S, typename B, typename H, typename K,
+				  typename = detail::if_elements_t<T>>
+		sum_t<T> dot(const Vector<T, A, G, S> &a, const Vector<T, B, H, K> &b) noexcept
+		{
+			return dot(a.data(), b.data(), a.size() < b.size() ? a.size() : b.size());
+		}
+
+		template <typename T, typename A, typename G, typename S, typename = detail::if_elements_t<T>>
+		bool contains_any(const Vector<T, A, G, S> &v, std::initializer_list<T> values) noexcept
+		{
+			return contains_any(v.data(), v.size(), values.begin(), values.size());
+		}
+
+		template <typename T, typename A, typename G, typename S, typename B, typename H, typename K,
+				  typename = detail::if_elements_t<T>>
+		bool contains_any(const Vector<T, A, G, S> &v, const Vector<T, B, H, K> &values) noexcept
+		{
+			return contains_any(v.data(), v.size(), values.data(), values.size());
+		}
+	}
+}
@@ -0,0 +1,632 @@
+#pragma once
+
+#include "Vector.h"
+
+namespace miv
+{
+	// SmallVector<T, N>: первые N элементов хранятся прямо в объекте,
+	// в аллокатор уходим только при росте сверх N.
+	template <typename T, std::size_t N, typename A = Allocator<T>>
+	class SmallVector
+	{
+		static_assert(N > 0, "SmallVector requires inline capacity N > 0");
+
+	public:
+		using value_type = T;
+		using allocator_type = A;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T &;
+		using const_reference = const T &;
+		using pointer = T *;
+		using const_pointer = const T *;
+		using iterator = VectorIterator<T>;
+		using const_iterator = VectorIterator<const T>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using alloc_traits = std::allocator_traits<allocator_type>;
+
+		static constexpr size_type inline_capacity = N;
+
+		SmallVector(const allocator_type &alloc = allocator_type()) noexcept
+			: alloc_(alloc), elem_(inline_data()), sz_(0), space_(N)
+		{
+		}
+
+		explicit SmallVector(size_type n, const T &value = T(),
+							 const allocator_type &alloc = allocator_type())
+			: SmallVector(alloc)
+		{
+			assign(n, value);
+		}
+
+		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		SmallVector(InputIt first, InputIt last,
+					const allocator_type &alloc = allocator_type())
+			: SmallVector(alloc)
+		{
+			assign(first, last);
+		}
+
+		SmallVector(std::initializer_list<T> il,
+					const allocator_type &alloc = allocator_type())
+			: SmallVector(il.begin(), il.end(), alloc)
+		{
+		}
+
+		SmallVector(const SmallVector &other)
+			: SmallVector(alloc_traits::select_on_container_copy_construction(other.alloc_))
+		{
+			reserve(other.sz_);
+			std::uninitialized_copy(other.elem_, other.elem_ + other.sz_, elem_);
+			sz_ = other.sz_;
+		}
+
+		SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			: SmallVector(std::move(other.alloc_))
+		{
+			steal(other);
+		}
+
+		SmallVector &operator=(const SmallVector &other)
+		{
+			if (this == &other)
+				return *this;
+			if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+			{
+				if (alloc_ != other.alloc_)
+				{
+					reset();
+					alloc_ = other.alloc_;
+				}
+			}
+			assign(other.begin(), other.end());
+			return *this;
+		}
+
+		SmallVector &operator=(SmallVector &&other) noexcept(
+			alloc_traits::propagate_on_container_move_assignment::value &&
+			std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this == &other)
+				return *this;
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+			{
+				reset();
+				alloc_ = std::move(other.alloc_);
+				steal(other);
+			}
+			else
+			{
+				if (alloc_ == other.alloc_)
+				{
+					reset();
+					steal(other);
+				}
+				else
+				{
+					assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+					other.clear();
+				}
+			}
+			return *this;
+		}
+
+		SmallVector &operator=(std::initializer_list<T> il)
+		{
+			assign(il.begin(), il.end());
+			return *this;
+		}
+
+		constexpr bool empty() const noexcept { return sz_ == 0; }
+		constexpr size_type size() const noexcept { return sz_; }
+		constexpr size_type capacity() const noexcept { return space_; }
+		bool is_inline() const noexcept { return elem_ == inline_data(); }
+
+		void reserve(size_type new_cap)
+		{
+			if (new_cap <= space_)
+				return;
+			if (!is_inline() && detail::expand(alloc_, elem_, space_, new_cap))
+				return;
+			adopt(relocate_to(alloc_traits::allocate(alloc_, new_cap), new_cap, sz_, 0), new_cap);
+		}
+
+		// Возврат во встроенный буфер, если элементы туда помещаются
+		void shrink_to_fit()
+		{
+			if (is_inline() || space_ == sz_)
+				return;
+			if (sz_ <= N)
+				adopt(relocate_to(inline_data(), 0, sz_, 0), N);
+			else
+				adopt(relocate_to(alloc_traits::allocate(alloc_, sz_), sz_, sz_, 0), sz_);
+		}
+
+		// Модификаторы
+		void clear() noexcept
+		{
+			for (size_type i = 0; i < sz_; ++i)
+				alloc_traits::destroy(alloc_, elem_ + i);
+			sz_ = 0;
+		}
+
+		void resize(size_type count, const T &value = T())
+		{
+			if (count < sz_)
+			{
+				for (size_type i = count; i < sz_; ++i)
+					alloc_traits::destroy(alloc_, elem_ + i);
+			}
+			else if (count > sz_)
+			{
+				// value может ссылаться на элемент: при росте копии строятся
+				// в новом блоке до переноса старых
+				if (count <= space_ ||
+					!grow_insert(sz_, count - sz_, [&](pointer p) { detail::construct_n(alloc_, p, count - sz_, value); }))
+					detail::construct_n(alloc_, elem_ + sz_, count - sz_, value);
+			}
+			sz_ = count;
+		}
+
+		void push_back(const T &v)
+		{
+			emplace_back(v);
+		}
+		void push_back(T &&v)
+		{
+			emplace_back(std::move(v));
+		}
+
+		// sv.push_back(sv[0]) при полном буфере корректен: новый элемент
+		// создаётся до переноса старых (см. grow_emplace)
+		template <typename... Args>
+		reference emplace_back(Args &&...args)
+		{
+			if (sz_ == space_)
+				grow_emplace(sz_, std::forward<Args>(args)...);
+			else
+			{
+				alloc_traits::construct(alloc_, elem_ + sz_, std::forward<Args>(args)...);
+				++sz_;
+			}
+			return elem_[sz_ - 1];
+		}
+
+		void pop_back() noexcept
+		{
+			if (sz_ > 0)
+				alloc_traits::destroy(alloc_, elem_ + --sz_);
+		}
+
+		// assign
+		void assign(size_type count, const T &value)
+		{
+			clear();
+			reserve(count);
+			for (size_type i = 0; i < count; ++i)
+				alloc_traits::construct(alloc_, elem_ + i, value);
+			sz_ = count;
+		}
+
+		template <typename InputIt,
+				  typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		void assign(InputIt first, InputIt last)
+		{
+			clear();
+			if constexpr (detail::is_forward_iterator_v<InputIt>)
+				reserve(static_cast<size_type>(std::distance(first, last)));
+			for (; first != last; ++first)
+				emplace_back(*first);
+		}
+
+		void assign(std::initializer_list<T> il)
+		{
+			assign(il.begin(), il.end());
+		}
+
+		// insert - emplace - erase. Значение, которое может ссылаться на
+		// элемент самого вектора, копируется до сдвига и роста
+		iterator insert(const_iterator pos, const T &value)
+		{
+			return emplace(pos, value);
+		}
+
+		iterator insert(const_iterator pos, T &&value)
+		{
+			return emplace(pos, std::move(value));
+		}
+
+		iterator insert(const_iterator pos, size_type count, const T &value)
+		{
+			size_type idx = pos - cbegin();
+			if (count == 0)
+				return iterator(elem_ + idx);
+			if (sz_ + count > space_ &&
+				grow_insert(idx, count, [&](pointer p) { detail::construct_n(alloc_, p, count, value); }))
+				return iterator(elem_ + idx);
+			T tmp(value);
+			detail::shift_right(alloc_, elem_, sz_, idx, count);
+			size_type i = 0;
+			try
+			{
+				for (; i < count; ++i)
+					alloc_traits::construct(alloc_, elem_ + idx + i, tmp);
+			}
+			catch (...)
+			{
+				detail::unshift_right(alloc_, elem_, sz_, idx, count, i);
+				throw;
+			}
+			sz_ += count;
+			return iterator(elem_ + idx);
+		}
+
+		template <typename InputIt,
+				  typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		iterator insert(const_iterator pos, InputIt first, InputIt last)
+		{
+			size_type idx = pos - cbegin();
+			if constexpr (!detail::is_forward_iterator_v<InputIt>)
+			{
+				// однопроходный диапазон нельзя измерить заранее: собираем его отдельно
+				SmallVector tmp(first, last, alloc_);
+				return insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+			}
+			size_type count = std::distance(first, last);
+			if (count == 0)
+				return iterator(elem_ + idx);
+			if (sz_ + count > space_ &&
+				grow_insert(idx, count, [&](pointer p) { detail::construct_range(alloc_, p, first, last); }))
+				return iterator(elem_ + idx);
+			detail::shift_right(alloc_, elem_, sz_, idx, count);
+			size_type i = 0;
+			try
+			{
+				for (; first != last; ++first, ++i)
+					alloc_traits::construct(alloc_, elem_ + idx + i, *first);
+			}
+			catch (...)
+			{
+				detail::unshift_right(alloc_, elem_, sz_, idx, count, i);
+				throw;
+			}
+			sz_ += count;
+			return iterator(elem_ + idx);
+		}
+
+		iterator insert(const_iterator pos, std::initializer_list<T> il)
+		{
+			return insert(pos, il.begin(), il.end());
+		}
+
+		template <typename... Args>
+		iterator emplace(const_iterator pos, Args &&...args)
+		{
+			size_type idx = pos - cbegin();
+			if (sz_ == space_)
+				grow_emplace(idx, std::forward<Args>(args)...);
+			else
+				emplace_here(idx, std::forward<Args>(args)...);
+			return iterator(elem_ + idx);
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			size_type idx = pos - cbegin();
+			alloc_traits::destroy(alloc_, elem_ + idx);
+			detail::shift_left(alloc_, elem_, sz_, idx + 1, 1);
+			--sz_;
+			return iterator(elem_ + idx);
+		}
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			size_type idx = first - cbegin();
+			size_type count = last - first;
+			for (size_type i = idx; i < idx + count; ++i)
+				alloc_traits::destroy(alloc_, elem_ + i);
+			detail::shift_left(alloc_, elem_, sz_, idx + count, count);
+			sz_ -= count;
+			return iterator(elem_ + idx);
+		}
+
+		// Два heap-буфера меняются указателями; если хотя бы один из векторов
+		// во встроенном буфере, элементы переносятся через временный объект.
+		void swap(SmallVector &other) noexcept(
+			alloc_traits::propagate_on_container_swap::value &&
+			std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this == &other)
+				return;
+			if constexpr (alloc_traits::propagate_on_container_swap::value)
+				std::swap(alloc_, other.alloc_);
+			if (!is_inline() && !other.is_inline())
+			{
+				std::swap(elem_, other.elem_);
+				std::swap(sz_, other.sz_);
+				std::swap(space_, other.space_);
+				return;
+			}
+			SmallVector tmp(alloc_);
+			tmp.steal(*this);
+			steal(other);
+			other.steal(tmp);
+		}
+
+		constexpr reference operator[](size_type i) noexcept { return elem_[i]; }
+		constexpr const_reference operator[](size_type i) const noexcept { return elem_[i]; }
+
+		reference at(size_type i)
+		{
+			if (i >= sz_)
+				throw Range_error(i);
+			return elem_[i];
+		}
+		const_reference at(size_type i) const
+		{
+			if (i >= sz_)
+				throw Range_error(i);
+			return elem_[i];
+		}
+
+		reference front() noexcept { return elem_[0]; }
+		const_reference front() const noexcept { return elem_[0]; }
+		reference back() noexcept { return elem_[sz_ - 1]; }
+		const_reference back() const noexcept { return elem_[sz_ - 1]; }
+
+		constexpr pointer data() noexcept { return elem_; }
+		constexpr const_pointer data() const noexcept { return elem_; }
+
+		iterator begin() noexcept { return iterator(elem_); }
+		const_iterator begin() const noexcept { return const_iterator(elem_); }
+		const_iterator cbegin() const noexcept { return const_iterator(elem_); }
+		iterator end() noexcept { return iterator(elem_ + sz_); }
+		const_iterator end() const noexcept { return const_iterator(elem_ + sz_); }
+		const_iterator cend() const noexcept { return const_iterator(elem_ + sz_); }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+		allocator_type get_allocator() const noexcept
+		{
+			return alloc_;
+		}
+
+		size_type max_size() const noexcept
+		{
+			return alloc_traits::max_size(alloc_);
+		}
+
+		~SmallVector()
+		{
+			reset();
+		}
+
+	private:
+		allocator_type alloc_;
+		pointer elem_;
+		size_type sz_, space_;
+		alignas(T) unsigned char buf_[N * sizeof(T)];
+
+		pointer inline_data() noexcept { return reinterpret_cast<pointer>(buf_); }
+		const_pointer inline_data() const noexcept { return reinterpret_cast<const_pointer>(buf_); }
+
+		// Ёмкость для роста до need элементов
+		size_type next_capacity(size_type need) const noexcept
+		{
+			return std::max(space_ * 2, need);
+		}
+
+		// Перенос элементов в new_elem с дырой из gap слотов в позиции idx.
+		// Если перенос бросил, new_elem (при cap > 0 - блок из аллокатора)
+		// освобождается, вектор не меняется
+		pointer relocate_to(pointer new_elem, size_type cap, size_type idx, size_type gap)
+		{
+			try
+			{
+				detail::relocate_around(alloc_, elem_, sz_, idx, gap, new_elem);
+			}
+			catch (...)
+			{
+				if (cap)
+					alloc_traits::deallocate(alloc_, new_elem, cap);
+				throw;
+			}
+			return new_elem;
+		}
+
+		// Старый heap-буфер освобождается, элементы уже перенесены
+		void adopt(pointer new_elem, size_type new_cap) noexcept
+		{
+			if (!is_inline())
+				alloc_traits::deallocate(alloc_, elem_, space_);
+			elem_ = new_elem;
+			space_ = new_cap;
+		}
+
+		// Рост для вставки count элементов в позицию idx: build(dst) строит
+		// их в новом блоке до переноса старых, поэтому аргументы могут
+		// ссылаться на элементы самого вектора. false - heap-блок вырос на
+		// месте, вставку делает вызывающий
+		template <typename Build>
+		bool grow_insert(size_type idx, size_type count, Build build)
+		{
+			size_type new_cap = next_capacity(sz_ + count);
+			if constexpr (detail::has_try_expand_v<A>)
+			{
+				if (!is_inline() && alloc_.try_expand(elem_, space_, new_cap))
+				{
+					space_ = new_cap;
+					return false;
+				}
+			}
+			pointer new_elem = alloc_traits::allocate(alloc_, new_cap);
+			try
+			{
+				build(new_elem + idx);
+			}
+			catch (...)
+			{
+				alloc_traits::deallocate(alloc_, new_elem, new_cap);
+				throw;
+			}
+			try
+			{
+				relocate_to(new_elem, 0, idx, count);
+			}
+			catch (...)
+			{
+				for (size_type i = 0; i < count; ++i)
+					alloc_traits::destroy(alloc_, new_elem + idx + i);
+				alloc_traits::deallocate(alloc_, new_elem, new_cap);
+				throw;
+			}
+			adopt(new_elem, new_cap);
+			sz_ += count;
+			return true;
+		}
+
+		template <typename... Args>
+		void grow_emplace(size_type idx, Args &&...args)
+		{
+			if constexpr (detail::has_reallocate_v<A> && is_trivially_relocatable_v<T>)
+			{
+				// reallocate (mremap) сдвигает heap-блок целиком, новый элемент
+				// ждёт во временном буфере и переносится побайтово
+				if (!is_inline())
+				{
+					alignas(T) unsigned char buf[sizeof(T)];
+					T *tmp = reinterpret_cast<T *>(buf);
+					alloc_traits::construct(alloc_, tmp, std::forward<Args>(args)...);
+					try
+					{
+						reserve(next_capacity(sz_ + 1));
+					}
+					catch (...)
+					{
+						alloc_traits::destroy(alloc_, tmp);
+						throw;
+					}
+					detail::shift_right(alloc_, elem_, sz_, idx, 1);
+					std::memcpy(static_cast<void *>(elem_ + idx), static_cast<const void *>(tmp), sizeof(T));
+					++sz_;
+					return;
+				}
+			}
+			if (!grow_insert(idx, 1,
+							 [&](pointer p) { alloc_traits::construct(alloc_, p, std::forward<Args>(args)...); }))
+				emplace_here(idx, std::forward<Args>(args)...);
+		}
+
+		// Вставка одного элемента при свободной ёмкости; элемент строится
+		// до сдвига: args могут ссылаться на хвост
+		template <typename... Args>
+		void emplace_here(size_type idx, Args &&...args)
+		{
+			if (idx == sz_)
+			{
+				alloc_traits::construct(alloc_, elem_ + sz_, std::forward<Args>(args)...);
+				++sz_;
+			}
+			else if constexpr (is_trivially_relocatable_v<T>)
+			{
+				alignas(T) unsigned char buf[sizeof(T)];
+				T *tmp = reinterpret_cast<T *>(buf);
+				alloc_traits::construct(alloc_, tmp, std::forward<Args>(args)...);
+				detail::shift_right(alloc_, elem_, sz_, idx, 1);
+				std::memcpy(static_cast<void *>(elem_ + idx), static_cast<const void *>(tmp), sizeof(T));
+				++sz_;
+			}
+			else
+			{
+				T tmp(std::forward<Args>(args)...);
+				detail::shift_right(alloc_, elem_, sz_, idx, 1);
+				try
+				{
+					alloc_traits::construct(alloc_, elem_ + idx, std::move(tmp));
+				}
+				catch (...)
+				{
+					detail::unshift_right(alloc_, elem_, sz_, idx, 1, 0);
+					throw;
+				}
+				++sz_;
+			}
+		}
+
+		// Уничтожить элементы, освободить heap-буфер и вернуться во встроенный
+		void reset() noexcept
+		{
+			clear();
+			if (!is_inline())
+				alloc_traits::deallocate(alloc_, elem_, space_);
+			elem_ = inline_data();
+			space_ = N;
+		}
+
+		// Забрать содержимое other (сам *this пуст и во встроенном буфере).
+		// heap-буфер забирается указателем, встроенный - переносом элементов.
+		void steal(SmallVector &other)
+		{
+			if (!other.is_inline())
+			{
+				elem_ = other.elem_;
+				space_ = other.space_;
+				sz_ = other.sz_;
+				other.elem_ = other.inline_data();
+				other.space_ = N;
+			}
+			else
+			{
+				detail::relocate(alloc_, other.elem_, other.sz_, elem_);
+				sz_ = other.sz_;
+			}
+			other.sz_ = 0;
+		}
+	};
+
+	template <typename T, std::size_t N, typename A>
+	void swap(SmallVector<T, N, A> &x, SmallVector<T, N, A> &y) noexcept(noexcept(x.swap(y)))
+	{
+		x.swap(y);
+	}
+
+	template <typename T, std::size_t N, typename A>
+	bool operator==(const SmallVector<T, N, A> &x, const SmallVector<T, N, A> &y)
+	{
+		if (x.size() != y.size())
+			return false;
+		return std::equal(x.begin(), x.end(), y.begin());
+	}
+	template <typename T, std::size_t N, typename A>
+	bool operator!=(const SmallVector<T, N, A> &x, const SmallVector<T, N, A> &y)
+	{
+		return !(x == y);
+	}
+	template <typename T, std::size_t N, typename A>
+	bool operator<(const SmallVector<T, N, A> &x, const SmallVector<T, N, A> &y)
+	{
+		return std::lexicographical_compare(x.begin(), x.end(),
+											y.begin(), y.end());
+	}
+	template <typename T, std::size_t N, typename A>
+	bool operator>(const SmallVector<T, N, A> &x, const SmallVector<T, N, A> &y)
+	{
+		return y < x;
+	}
+	template <typename T, std::size_t N, typename A>
+	bool operator<=(const SmallVector<T, N, A> &x, const SmallVector<T, N, A> &y)
+	{
+		return !(y < x);
+	}
+	template <typename T, std::size_t N, typename A>
+	bool operator>=(const SmallVector<T, N, A> &x, const SmallVector<T, N, A> &y)
+	{
+		return !(x < y);
+	}
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Vector.h"
+
+namespace miv
+{
+	// Эпохи для освобождения снимков (epoch-based reclamation). У каждого
+	// читающего потока свой слот на отдельной кэш-линии: входя в чтение, поток
+	// записывает в него текущую эпоху, выходя - 0. Писатель, убрав снимок из
+	// обращения, сдвигает эпоху и освобождает его, когда все занятые слоты
+	// показывают эпоху не меньше эпохи удаления. Читатели не пишут в общую
+	// память, поэтому не мешают друг другу.
+	class EpochDomain
+	{
+	public:
+		struct alignas(64) Slot
+		{
+			std::atomic<std::uint64_t> epoch{ 0 };
+			std::atomic<bool> in_use{ true };
+			Slot *next = nullptr;
+			unsigned depth = 0; // вложенные чтения, только поток-владелец
+		};
+
+		EpochDomain(const EpochDomain &) = delete;
+		EpochDomain &operator=(const EpochDomain &) = delete;
+
+		static EpochDomain &instance()
+		{
+			static EpochDomain domain;
+			return domain;
+		}
+
+		// Вложенное чтение держит эпоху внешнего
+		Slot &enter()
+		{
+			Slot &s = local_slot();
+			if (s.depth++ == 0)
+				s.epoch.store(epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+			return s;
+		}
+
+		void leave(Slot &s) noexcept
+		{
+			if (--s.depth == 0)
+				s.epoch.store(0, std::memory_order_release);
+		}
+
+		// Новая эпоха; объекты, убранные из обращения до вызова, помечаются ею
+		std::uint64_t advance() noexcept
+		{
+			return epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+		}
+
+		// Объект с эпохой удаления e можно освобождать, если e <= min_active()
+		std::uint64_t min_active() const noexcept
+		{
+			std::uint64_t m = std::numeric_limits<std::uint64_t>::max();
+			for (Slot *s = head_.load(std::memory_order_acquire); s; s = s->next)
+			{
+				std::uint64_t e = s->epoch.load(std::memory_order_seq_cst);
+				if (e && e < m)
+					m = e;
+			}
+			return m;
+		}
+
+	private:
+		std::atomic<std::uint64_t> epoch_{ 1 };
+		std::atomic<Slot *> head_{ nullptr };
+
+		EpochDomain() = default;
+
+		// Слот освобождается при завершении потока и достаётся следующему;
+		// сами слоты живут до конца программы
+		struct Release
+		{
+			Slot *slot = nullptr;
+			~Release()
+			{
+				if (slot)
+					slot->in_use.store(false, std::memory_order_release);
+			}
+		};
+
+		Slot &local_slot()
+		{
+			static thread_local Slot *slot = nullptr;
+			if (!slot)
+				slot = &acquire_slot();
+			return *slot;
+		}
+
+		Slot &acquire_slot()
+		{
+			static thread_local Release release;
+			for (Slot *s = head_.load(std::memory_order_acquire); s; s = s->next)
+			{
+				bool free = false;
+				if (!s->in_use.load(std::memory_order_relaxed) &&
+					s->in_use.compare_exchange_strong(free, true, std::memory_order_acquire))
+					return *(release.slot = s);
+			}
+			Slot *s = new Slot;
+			s->next = head_.load(std::memory_order_relaxed);
+			while (!head_.compare_exchange_weak(s->next, s, std::memory_order_release, std::memory_order_relaxed))
+			{
+			}
+			return *(release.slot = s);
+		}
+	};
+
+	// SnapshotVector<T>: неизменяемые снимки Vector для многих читателей и
+	// редкого писателя (RCU). Писатель строит новый Vector и публикует его
+	// одной атомарной заменой указателя; read() даёт охранный объект, через
+	// который снимок читается без блокировок и счётчиков ссылок. Старый
+	// снимок освобождается, когда его не может читать ни один поток.
+	//
+	// Охранный объект разрушается в том же потоке; пока он жив, поток не
+	// должен вызывать synchronize(). Долгое чтение задерживает освобождение
+	// всех снимков, снятых после его начала. Писатели сериализуются mutex.
+	template <typename T, typename A = Allocator<T>>
+	class SnapshotVector
+	{
+	public:
+		using vector_type = Vector<T, A>;
+		using value_type = T;
+		using size_type = std::size_t;
+		using const_reference = const T &;
+		using const_iterator = typename vector_type::const_iterator;
+
+		// Снимок, закреплённый на время жизни объекта
+		class Reader
+		{
+		public:
+			Reader(Reader &&other) noexcept : v_(other.v_), slot_(other.slot_)
+			{
+				other.slot_ = nullptr;
+			}
+			Reader(const Reader &) = delete;
+			Reader &operator=(const Reader &) = delete;
+			Reader &operator=(Reader &&) = delete;
+
+			~Reader()
+			{
+				if (slot_)
+					EpochDomain::instance().leave(*slot_);
+			}
+
+			const vector_type &operator*() const noexcept { return *v_; }
+			const vector_type *operator->() const noexcept { return v_; }
+			const vector_type &get() const noexcept { return *v_; }
+
+			size_type size() const noexcept { return v_->size(); }
+			bool empty() const noexcept { return v_->empty(); }
+			const_reference operator[](size_type i) const noexcept { return (*v_)[i]; }
+			const T *data() const noexcept { return v_->data(); }
+			const_iterator begin() const noexcept { return v_->begin(); }
+			const_iterator end() const noexcept { return v_->end(); }
+
+		private:
+			friend class SnapshotVector;
+			const vector_type *v_;
+			EpochDomain::Slot *slot_;
+
+			Reader(const vector_type *v, EpochDomain::Slot *slot) noexcept : v_(v), slot_(slot) {}
+		};
+
+		SnapshotVector() : SnapshotVector(vector_type()) {}
+
+		explicit SnapshotVector(vector_type v) : current_(new vector_type(std::move(v))) {}
+
+		SnapshotVector(std::initializer_list<T> il) : SnapshotVector(vector_type(il)) {}
+
+		SnapshotVector(const SnapshotVector &) = delete;
+		SnapshotVector &operator=(const SnapshotVector &) = delete;
+
+		// Только без читателей этого объекта
+		~SnapshotVector()
+		{
+			delete current_.load(std::memory_order_relaxed);
+			for (Retired &r : retired_)
+				delete r.v;
+		}
+
+		// Вход в чтение: слот потока получает текущую эпоху до загрузки указателя
+		Reader read() const
+		{
+			EpochDomain::Slot &s = EpochDomain::instance().enter();
+			return Reader(current_.load(std::memory_order_seq_cst), &s);
+		}
+
+		// Копия текущего снимка
+		vector_type copy() const
+		{
+			Reader r = read();
+			return *r;
+		}
+
+		// Заменить содержимое; старый снимок освобождается, когда это безопасно
+		void publish(vector_type v)
+		{
+			std::lock_guard<std::mutex> lock(write_m_);
+			replace(std::move(v));
+		}
+
+		// Копирование при записи: f получает копию текущего снимка
+		template <typename F>
+		void update(F f)
+		{
+			std::lock_guard<std::mutex> lock(write_m_);
+			vector_type next(*current_.load(std::memory_order_relaxed));
+			f(next);
+			replace(std::move(next));
+		}
+
+		// Освободить то, что уже можно; число ещё ждущих снимков
+		size_type reclaim()
+		{
+			std::lock_guard<std::mutex> lock(write_m_);
+			collect();
+			return retired_.size();
+		}
+
+		// Дождаться, пока освободятся все старые снимки
+		void synchronize()
+		{
+			while (reclaim() != 0)
+				std::this_thread::yield();
+		}
+
+	private:
+		struct Retired
+		{
+			vector_type *v;
+			std::uint64_t epoch;
+		};
+
+		std::atomic<vector_type *> current_;
+		std::mutex write_m_;
+		Vector<Retired> retired_;
+
+		// Под write_m_. Место в retired_ - до замены, чтобы после неё не бросать
+		void replace(vector_type &&v)
+		{
+			retired_.reserve(retired_.size() + 1);
+			std::unique_ptr<vector_type> fresh(new vector_type(std::move(v)));
+			vector_type *old = current_.exchange(fresh.release(), std::memory_order_seq_cst);
+			retired_.push_back(Retired{ old, EpochDomain::instance().advance() });
+			collect();
+		}
+
+		void collect() noexcept
+		{
+			std::uint64_t safe = EpochDomain::instance().min_active();
+			size_type kept = 0;
+			for (Retired &r : retired_)
+			{
+				if (r.epoch <= safe)
+					delete r.v;
+				else
+					retired_[kept++] = r;
+			}
+			retired_.erase(retired_.begin() + kept, retired_.end());
+		}
+	};
+}
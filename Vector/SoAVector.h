@@ -0,0 +1,394 @@
+#pragma once
+
+#include "Allocators.h"
+#include <tuple>
+#include <utility>
+
+namespace miv
+{
+	// Прокси-ссылка на запись SoAVector: кортеж ссылок на элементы всех
+	// колонок. std::get / структурные привязки работают через базу
+	// std::tuple<Fields &...>; присваивание - поэлементное, swap - по колонкам,
+	// поэтому std::sort и другие перестановочные алгоритмы работают через
+	// итераторы SoAVector.
+	template <typename... Fields>
+	class SoARef : public std::tuple<Fields &...>
+	{
+		using base = std::tuple<Fields &...>;
+
+	public:
+		using value_type = std::tuple<std::remove_const_t<Fields>...>;
+
+		explicit SoARef(Fields &...fields) noexcept : base(fields...) {}
+		SoARef(const SoARef &) = default;
+
+		base &refs() noexcept { return *this; }
+		const base &refs() const noexcept { return *this; }
+
+		// Прокси-значение s[i] - всегда rvalue, но ссылается на живые элементы,
+		// поэтому и преобразование, и присваивание из SoARef копируют. Перемещать
+		// можно только из настоящего value_type (временная переменная в sort)
+		operator value_type() const { return value_type(refs()); }
+
+		// Присваивание прокси всегда пишет в элементы, а не перевешивает ссылки
+		const SoARef &operator=(const SoARef &other) const
+		{
+			assign(other.refs(), std::index_sequence_for<Fields...>{});
+			return *this;
+		}
+		const SoARef &operator=(const value_type &v) const
+		{
+			assign(v, std::index_sequence_for<Fields...>{});
+			return *this;
+		}
+		const SoARef &operator=(value_type &&v) const
+		{
+			move_assign(v, std::index_sequence_for<Fields...>{});
+			return *this;
+		}
+
+		friend void swap(SoARef a, SoARef b)
+		{
+			swap_fields(a, b, std::index_sequence_for<Fields...>{});
+		}
+
+	private:
+		template <typename Tuple, std::size_t... I>
+		void assign(const Tuple &t, std::index_sequence<I...>) const
+		{
+			((std::get<I>(static_cast<const base &>(*this)) = std::get<I>(t)), ...);
+		}
+		template <typename Tuple, std::size_t... I>
+		void move_assign(Tuple &t, std::index_sequence<I...>) const
+		{
+			((std::get<I>(static_cast<const base &>(*this)) = std::move(std::get<I>(t))), ...);
+		}
+		template <std::size_t... I>
+		static void swap_fields(SoARef &a, SoARef &b, std::index_sequence<I...>)
+		{
+			using std::swap;
+			(swap(std::get<I>(a.refs()), std::get<I>(b.refs())), ...);
+		}
+	};
+
+	// Random-access итератор по индексу, разыменование даёт SoARef
+	template <typename C, typename Ref>
+	class SoAIterator
+	{
+	private:
+		template <typename, typename>
+		friend class SoAIterator;
+		C *owner_;
+		std::size_t idx_;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = typename Ref::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = Ref;
+
+		SoAIterator() noexcept : owner_(nullptr), idx_(0) {}
+		SoAIterator(C *owner, std::size_t idx) noexcept : owner_(owner), idx_(idx) {}
+
+		template <typename D, typename R, typename = std::enable_if_t<std::is_convertible_v<D *, C *>>>
+		SoAIterator(const SoAIterator<D, R> &other) noexcept
+			: owner_(other.owner_), idx_(other.idx_)
+		{
+		}
+
+		reference operator*() const noexcept { return (*owner_)[idx_]; }
+		reference operator[](difference_type n) const noexcept { return (*owner_)[idx_ + n]; }
+		std::size_t index() const noexcept { return idx_; }
+
+		SoAIterator &operator++() noexcept
+		{
+			++idx_;
+			return *this;
+		}
+		SoAIterator operator++(int) noexcept
+		{
+			SoAIterator tmp(*this);
+			++idx_;
+			return tmp;
+		}
+		SoAIterator &operator--() noexcept
+		{
+			--idx_;
+			return *this;
+		}
+		SoAIterator operator--(int) noexcept
+		{
+			SoAIterator tmp(*this);
+			--idx_;
+			return tmp;
+		}
+		SoAIterator &operator+=(difference_type n) noexcept
+		{
+			idx_ += n;
+			return *this;
+		}
+		SoAIterator &operator-=(difference_type n) noexcept
+		{
+			idx_ -= n;
+			return *this;
+		}
+
+		SoAIterator operator+(difference_type n) const noexcept { return SoAIterator(owner_, idx_ + n); }
+		friend SoAIterator operator+(difference_type n, const SoAIterator &it) noexcept { return it + n; }
+		SoAIterator operator-(difference_type n) const noexcept { return SoAIterator(owner_, idx_ - n); }
+		difference_type operator-(const SoAIterator &o) const noexcept
+		{
+			return static_cast<difference_type>(idx_) - static_cast<difference_type>(o.idx_);
+		}
+
+		bool operator==(const SoAIterator &o) const noexcept { return idx_ == o.idx_; }
+		bool operator!=(const SoAIterator &o) const noexcept { return idx_ != o.idx_; }
+		bool operator<(const SoAIterator &o) const noexcept { return idx_ < o.idx_; }
+		bool operator>(const SoAIterator &o) const noexcept { return idx_ > o.idx_; }
+		bool operator<=(const SoAIterator &o) const noexcept { return idx_ <= o.idx_; }
+		bool operator>=(const SoAIterator &o) const noexcept { return idx_ >= o.idx_; }
+	};
+
+	// SoAVector<Fields...>: каждое поле записи хранится в своей колонке -
+	// Vector с выравниванием по кэш-линии (AlignedAllocator) и обычной
+	// политикой роста. Колонки всегда одного размера. Сканирование одного
+	// поля читает только его колонку; data<I>() отдаёт её для SIMD-ядер.
+	template <typename... Fields>
+	class SoAVector
+	{
+		static_assert(sizeof...(Fields) > 0, "SoAVector requires at least one field");
+
+	public:
+		using value_type = std::tuple<Fields...>;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = SoARef<Fields...>;
+		using const_reference = SoARef<const Fields...>;
+		using iterator = SoAIterator<SoAVector, reference>;
+		using const_iterator = SoAIterator<const SoAVector, const_reference>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		template <std::size_t I>
+		using field_type = std::tuple_element_t<I, value_type>;
+		template <std::size_t I>
+		using column_type = Vector<field_type<I>, AlignedAllocator<field_type<I>>>;
+
+		static constexpr size_type field_count = sizeof...(Fields);
+
+		SoAVector() = default;
+
+		SoAVector(std::initializer_list<value_type> il)
+		{
+			reserve(il.size());
+			for (const value_type &v : il)
+				push_back(v);
+		}
+
+		size_type size() const noexcept { return std::get<0>(cols_).size(); }
+		bool empty() const noexcept { return size() == 0; }
+
+		size_type capacity() const noexcept
+		{
+			size_type cap = std::numeric_limits<size_type>::max();
+			each([&](const auto &c) { cap = std::min(cap, c.capacity()); });
+			return cap;
+		}
+
+		void reserve(size_type n)
+		{
+			each([n](auto &c) { c.reserve(n); });
+		}
+
+		void shrink_to_fit()
+		{
+			each([](auto &c) { c.shrink_to_fit(); });
+		}
+
+		void clear() noexcept
+		{
+			each([](auto &c) { c.clear(); });
+		}
+
+		// При исключении уже выросшие колонки возвращаются к прежнему размеру
+		void resize(size_type n)
+		{
+			size_type old = size();
+			try
+			{
+				each([n](auto &c) { c.resize(n); });
+			}
+			catch (...)
+			{
+				each([old](auto &c) {
+					if (c.size() > old)
+						c.resize(old);
+				});
+				throw;
+			}
+		}
+
+		void push_back(const value_type &v)
+		{
+			std::apply([this](const auto &...f) { emplace_back(f...); }, v);
+		}
+		void push_back(value_type &&v)
+		{
+			std::apply([this](auto &...f) { emplace_back(std::move(f)...); }, v);
+		}
+
+		// По одному аргументу на поле
+		template <typename... Args>
+		reference emplace_back(Args &&...args)
+		{
+			static_assert(sizeof...(Args) == sizeof...(Fields), "emplace_back takes one argument per field");
+			emplace_columns(std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+			return back();
+		}
+
+		void pop_back() noexcept
+		{
+			each([](auto &c) { c.pop_back(); });
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			size_type a = first.index(), b = last.index();
+			each([a, b](auto &c) { c.erase(c.begin() + a, c.begin() + b); });
+			return iterator(this, a);
+		}
+
+		reference operator[](size_type i) noexcept
+		{
+			return row(i, std::index_sequence_for<Fields...>{});
+		}
+		const_reference operator[](size_type i) const noexcept
+		{
+			return row(i, std::index_sequence_for<Fields...>{});
+		}
+
+		reference at(size_type i)
+		{
+			if (i >= size())
+				throw Range_error(i);
+			return (*this)[i];
+		}
+		const_reference at(size_type i) const
+		{
+			if (i >= size())
+				throw Range_error(i);
+			return (*this)[i];
+		}
+
+		reference front() noexcept { return (*this)[0]; }
+		const_reference front() const noexcept { return (*this)[0]; }
+		reference back() noexcept { return (*this)[size() - 1]; }
+		const_reference back() const noexcept { return (*this)[size() - 1]; }
+
+		// Колонка I целиком и её непрерывные данные (выровнены по 64 байтам)
+		template <std::size_t I>
+		column_type<I> &column() noexcept { return std::get<I>(cols_); }
+		template <std::size_t I>
+		const column_type<I> &column() const noexcept { return std::get<I>(cols_); }
+
+		template <std::size_t I>
+		field_type<I> *data() noexcept { return std::get<I>(cols_).data(); }
+		template <std::size_t I>
+		const field_type<I> *data() const noexcept { return std::get<I>(cols_).data(); }
+
+		iterator begin() noexcept { return iterator(this, 0); }
+		const_iterator begin() const noexcept { return const_iterator(this, 0); }
+		const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+		iterator end() noexcept { return iterator(this, size()); }
+		const_iterator end() const noexcept { return const_iterator(this, size()); }
+		const_iterator cend() const noexcept { return const_iterator(this, size()); }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+		void swap(SoAVector &other) noexcept
+		{
+			cols_.swap(other.cols_);
+		}
+
+		friend bool operator==(const SoAVector &x, const SoAVector &y)
+		{
+			return x.cols_ == y.cols_;
+		}
+		friend bool operator!=(const SoAVector &x, const SoAVector &y)
+		{
+			return !(x == y);
+		}
+
+	private:
+		std::tuple<Vector<Fields, AlignedAllocator<Fields>>...> cols_;
+
+		template <typename F>
+		void each(F f)
+		{
+			std::apply([&f](auto &...c) { (f(c), ...); }, cols_);
+		}
+		template <typename F>
+		void each(F f) const
+		{
+			std::apply([&f](const auto &...c) { (f(c), ...); }, cols_);
+		}
+
+		template <std::size_t... I>
+		reference row(size_type i, std::index_sequence<I...>) noexcept
+		{
+			return reference(std::get<I>(cols_)[i]...);
+		}
+		template <std::size_t... I>
+		const_reference row(size_type i, std::index_sequence<I...>) const noexcept
+		{
+			return const_reference(std::get<I>(cols_)[i]...);
+		}
+
+		template <std::size_t... I, typename... Args>
+		void emplace_columns(std::index_sequence<I...>, Args &&...args)
+		{
+			size_type done = 0;
+			try
+			{
+				((std::get<I>(cols_).emplace_back(std::forward<Args>(args)), ++done), ...);
+			}
+			catch (...)
+			{
+				size_type k = 0;
+				each([&](auto &c) {
+					if (k++ < done)
+						c.pop_back();
+				});
+				throw;
+			}
+		}
+	};
+
+	template <typename... Fields>
+	void swap(SoAVector<Fields...> &a, SoAVector<Fields...> &b) noexcept
+	{
+		a.swap(b);
+	}
+}
+
+// Структурные привязки: auto [x, y] = soa[i];
+namespace std
+{
+	template <typename... Fields>
+	struct tuple_size<miv::SoARef<Fields...>> : std::integral_constant<std::size_t, sizeof...(Fields)>
+	{
+	};
+	template <std::size_t I, typename... Fields>
+	struct tuple_element<I, miv::SoARef<Fields...>>
+	{
+		using type = std::tuple_element_t<I, std::tuple<Fields &...>>;
+	};
+}
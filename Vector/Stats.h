@@ -0,0 +1,233 @@
+#pragma once
+
+#include "Vector.h"
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <typeinfo>
+
+#if defined(__has_include)
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define MIV_HAS_CXXABI 1
+#endif
+#endif
+
+namespace miv
+{
+	// Счётчики одного места использования. Все поля атомарные (relaxed):
+	// векторы с одним тегом могут жить в разных потоках.
+	struct StatsCounters
+	{
+		std::atomic<std::uint64_t> allocations{ 0 };
+		std::atomic<std::uint64_t> deallocations{ 0 };
+		std::atomic<std::uint64_t> bytes_allocated{ 0 };
+		std::atomic<std::uint64_t> bytes_freed{ 0 };
+		std::atomic<std::uint64_t> reallocations[3] = {}; // по ReallocReason
+		std::atomic<std::uint64_t> relocated{ 0 };		   // перенесённые элементы
+		std::atomic<std::uint64_t> peak_capacity{ 0 };	   // самый большой блок, байт
+		std::atomic<std::uint64_t> peak_live{ 0 };		   // максимум занятых байт сразу
+		std::atomic<std::uint64_t> slack{ 0 };			   // неиспользованные байты освобождённых блоков
+
+		std::uint64_t live_bytes() const noexcept
+		{
+			return bytes_allocated.load(std::memory_order_relaxed) - bytes_freed.load(std::memory_order_relaxed);
+		}
+
+		void reset() noexcept
+		{
+			for (auto *c : { &allocations, &deallocations, &bytes_allocated, &bytes_freed, &relocated,
+							 &peak_capacity, &peak_live, &slack })
+				c->store(0, std::memory_order_relaxed);
+			for (auto &c : reallocations)
+				c.store(0, std::memory_order_relaxed);
+		}
+	};
+
+	namespace detail
+	{
+		inline void atomic_max(std::atomic<std::uint64_t> &a, std::uint64_t v) noexcept
+		{
+			std::uint64_t cur = a.load(std::memory_order_relaxed);
+			while (cur < v && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		inline void json_string(std::ostream &os, const std::string &s)
+		{
+			os << '"';
+			for (char ch : s)
+			{
+				if (ch == '"' || ch == '\\')
+					os << '\\' << ch;
+				else if (static_cast<unsigned char>(ch) < 0x20)
+					os << ' ';
+				else
+					os << ch;
+			}
+			os << '"';
+		}
+
+		template <typename Tag, typename = void>
+		struct has_stats_name : std::false_type
+		{
+		};
+		template <typename Tag>
+		struct has_stats_name<Tag, std::void_t<decltype(Tag::name)>> : std::true_type
+		{
+		};
+
+		// Имя места: Tag::name, если есть, иначе имя типа тега
+		template <typename Tag>
+		std::string stats_name()
+		{
+			if constexpr (has_stats_name<Tag>::value)
+				return Tag::name;
+			else
+			{
+				const char *raw = typeid(Tag).name();
+#ifdef MIV_HAS_CXXABI
+				int status = 0;
+				char *demangled = abi::__cxa_demangle(raw, nullptr, nullptr, &status);
+				if (demangled)
+				{
+					std::string name(demangled);
+					std::free(demangled);
+					return name;
+				}
+#endif
+				return raw;
+			}
+		}
+	}
+
+	// Реестр всех мест со статистикой в процессе. Место регистрируется при
+	// первом событии своего тега и живёт до конца программы.
+	class StatsRegistry
+	{
+	public:
+		struct Site
+		{
+			std::string name;
+			const StatsCounters *counters;
+		};
+
+		static StatsRegistry &instance()
+		{
+			static StatsRegistry r;
+			return r;
+		}
+
+		// Ошибка регистрации (нехватка памяти) не должна ронять вектор:
+		// место просто не попадёт в отчёт
+		void add(std::string name, const StatsCounters *c) noexcept
+		{
+			try
+			{
+				std::lock_guard<std::mutex> lock(m_);
+				sites_.push_back({ std::move(name), c });
+			}
+			catch (...)
+			{
+			}
+		}
+
+		template <typename F>
+		void for_each(F f) const
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			for (const Site &s : sites_)
+				f(s.name, *s.counters);
+		}
+
+		void reset() noexcept
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			for (const Site &s : sites_)
+				const_cast<StatsCounters *>(s.counters)->reset();
+		}
+
+		// {"sites":[{"name":..., "allocations":..., ...}, ...]}
+		void dump_json(std::ostream &os) const
+		{
+			static const char *const reasons[] = { "reserve", "push_back", "insert" };
+			auto get = [](const std::atomic<std::uint64_t> &a) { return a.load(std::memory_order_relaxed); };
+			os << "{\"sites\":[";
+			bool first = true;
+			for_each([&](const std::string &name, const StatsCounters &c) {
+				os << (first ? "" : ",") << "{\"name\":";
+				first = false;
+				detail::json_string(os, name);
+				os << ",\"allocations\":" << get(c.allocations)
+				   << ",\"deallocations\":" << get(c.deallocations)
+				   << ",\"bytes_allocated\":" << get(c.bytes_allocated)
+				   << ",\"bytes_freed\":" << get(c.bytes_freed)
+				   << ",\"live_bytes\":" << c.live_bytes()
+				   << ",\"reallocations\":{";
+				for (int r = 0; r < 3; ++r)
+					os << (r ? "," : "") << '"' << reasons[r] << "\":" << get(c.reallocations[r]);
+				os << "},\"relocated_elements\":" << get(c.relocated)
+				   << ",\"peak_capacity_bytes\":" << get(c.peak_capacity)
+				   << ",\"peak_live_bytes\":" << get(c.peak_live)
+				   << ",\"slack_bytes\":" << get(c.slack) << '}';
+			});
+			os << "]}";
+		}
+
+		std::string to_json() const
+		{
+			std::ostringstream os;
+			dump_json(os);
+			return os.str();
+		}
+
+	private:
+		mutable std::mutex m_;
+		Vector<Site> sites_;
+
+		StatsRegistry() = default;
+	};
+
+	// Политика статистики для Vector<T, A, G, Stats<Tag>>: один набор
+	// счётчиков на тег, т.е. на место использования в коде
+	//   struct parser_tokens { static constexpr const char *name = "parser.tokens"; };
+	//   Vector<Token, Allocator<Token>, DoublingGrowth<>, Stats<parser_tokens>> tokens;
+	template <typename Tag>
+	struct Stats
+	{
+		static StatsCounters &counters() noexcept
+		{
+			static StatsCounters c;
+			static const bool registered = (StatsRegistry::instance().add(detail::stats_name<Tag>(), &c), true);
+			(void)registered;
+			return c;
+		}
+
+		static void on_allocate(std::size_t bytes) noexcept
+		{
+			StatsCounters &c = counters();
+			c.allocations.fetch_add(1, std::memory_order_relaxed);
+			c.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+			detail::atomic_max(c.peak_capacity, bytes);
+			detail::atomic_max(c.peak_live, c.live_bytes());
+		}
+
+		static void on_deallocate(std::size_t bytes, std::size_t slack) noexcept
+		{
+			StatsCounters &c = counters();
+			c.deallocations.fetch_add(1, std::memory_order_relaxed);
+			c.bytes_freed.fetch_add(bytes, std::memory_order_relaxed);
+			c.slack.fetch_add(slack, std::memory_order_relaxed);
+		}
+
+		static void on_reallocate(ReallocReason why, std::size_t, std::size_t, std::size_t relocated) noexcept
+		{
+			StatsCounters &c = counters();
+			c.reallocations[static_cast<int>(why)].fetch_add(1, std::memory_order_relaxed);
+			c.relocated.fetch_add(relocated, std::memory_order_relaxed);
+		}
+	};
+}
@@ -9,6 +9,18 @@
 #include <cstddef>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <cstring>
+#include <cstdint>
+#include <new>
+
+#if defined(__has_include)
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <sys/mman.h>
+#include <unistd.h>
+#define MIV_HAS_MMAP 1
+#endif
+#endif
 
 namespace miv
 {
@@ -21,6 +33,123 @@ namespace miv
 		}
 	};
 
+	namespace detail
+	{
+		// Большие блоки выделяются страницами напрямую через mmap, чтобы их
+		// можно было растить через mremap без копирования.
+		inline constexpr std::size_t mmap_threshold = std::size_t(1) << 20;
+
+#ifdef MIV_HAS_MMAP
+		inline std::size_t page_size() noexcept
+		{
+			static const std::size_t sz = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+			return sz;
+		}
+
+		inline std::size_t round_to_pages(std::size_t bytes) noexcept
+		{
+			std::size_t ps = page_size();
+			return (bytes + ps - 1) / ps * ps;
+		}
+
+		inline void *map_pages(std::size_t bytes)
+		{
+			void *p = ::mmap(nullptr, round_to_pages(bytes), PROT_READ | PROT_WRITE,
+							 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p == MAP_FAILED)
+				throw std::bad_alloc();
+			return p;
+		}
+
+		inline void unmap_pages(void *p, std::size_t bytes) noexcept
+		{
+			::munmap(p, round_to_pages(bytes));
+		}
+
+		// Блоки под прозрачные huge pages: выравнивание и размер кратны 2 MiB,
+		// иначе ядро не сможет отдать их целыми huge-страницами.
+		inline constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+		inline std::size_t round_to_huge_pages(std::size_t bytes) noexcept
+		{
+			return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+		}
+
+		inline void *map_huge_pages(std::size_t bytes)
+		{
+			std::size_t len = round_to_huge_pages(bytes);
+			void *raw = ::mmap(nullptr, len + huge_page_size, PROT_READ | PROT_WRITE,
+							   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (raw == MAP_FAILED)
+				throw std::bad_alloc();
+			char *base = static_cast<char *>(raw);
+			char *p = reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(base) + huge_page_size - 1) &
+											   ~(std::uintptr_t(huge_page_size) - 1));
+			// отрезаем невыровненные голову и хвост
+			if (p != base)
+				::munmap(base, static_cast<std::size_t>(p - base));
+			if (std::size_t tail = huge_page_size - static_cast<std::size_t>(p - base))
+				::munmap(p + len, tail);
+#ifdef MADV_HUGEPAGE
+			::madvise(p, len, MADV_HUGEPAGE);
+#endif
+			return p;
+		}
+
+		inline void unmap_huge_pages(void *p, std::size_t bytes) noexcept
+		{
+			::munmap(p, round_to_huge_pages(bytes));
+		}
+
+		// Перемапливает блок на новый размер. Без may_move пытается только
+		// расширить на месте и возвращает nullptr при неудаче.
+		inline void *remap_pages(void *p, std::size_t old_bytes, std::size_t new_bytes, bool may_move) noexcept
+		{
+			std::size_t old_len = round_to_pages(old_bytes), new_len = round_to_pages(new_bytes);
+			if (old_len == new_len)
+				return p;
+#ifdef __linux__
+			void *r = ::mremap(p, old_len, new_len, may_move ? MREMAP_MAYMOVE : 0);
+			return r == MAP_FAILED ? nullptr : r;
+#else
+			(void)may_move;
+			return nullptr;
+#endif
+		}
+#endif
+
+		// Необязательные расширения аллокатора:
+		//   bool    try_expand(pointer p, size_type old_n, size_type new_n) - рост блока на месте;
+		//   pointer reallocate(pointer p, size_type old_n, size_type new_n) - рост с возможным
+		//           побайтовым переносом (только для trivially relocatable T).
+		template <typename A, typename = void>
+		struct has_try_expand : std::false_type
+		{
+		};
+		template <typename A>
+		struct has_try_expand<A, std::void_t<decltype(std::declval<A &>().try_expand(
+									 std::declval<typename std::allocator_traits<A>::pointer>(),
+									 std::size_t{}, std::size_t{}))>> : std::true_type
+		{
+		};
+
+		template <typename A, typename = void>
+		struct has_reallocate : std::false_type
+		{
+		};
+		template <typename A>
+		struct has_reallocate<A, std::void_t<decltype(std::declval<A &>().reallocate(
+									 std::declval<typename std::allocator_traits<A>::pointer>(),
+									 std::size_t{}, std::size_t{}))>> : std::true_type
+		{
+		};
+
+		template <typename A>
+		inline constexpr bool has_try_expand_v = has_try_expand<A>::value;
+		template <typename A>
+		inline constexpr bool has_reallocate_v = has_reallocate<A>::value;
+	}
+
 	template <typename T>
 	class Allocator
 	{
@@ -47,11 +176,54 @@ namespace miv
 		{
 			if (n > max_size())
 				throw std::bad_alloc();
-			return static_cast<pointer>(::operator new(n * sizeof(T)));
+#ifdef MIV_HAS_MMAP
+			if (is_mapped(n))
+				return static_cast<pointer>(detail::map_pages(n * sizeof(T)));
+#endif
+			if constexpr (over_aligned)
+				return static_cast<pointer>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+			else
+				return static_cast<pointer>(::operator new(n * sizeof(T)));
+		}
+		void deallocate(pointer p, size_type n) noexcept
+		{
+#ifdef MIV_HAS_MMAP
+			if (is_mapped(n))
+				return detail::unmap_pages(p, n * sizeof(T));
+#endif
+			if constexpr (over_aligned)
+				::operator delete(p, std::align_val_t(alignof(T)));
+			else
+				::operator delete(p);
 		}
-		void deallocate(pointer p, size_type) noexcept
+
+		// Рост блока на месте; возможен только для mmap-блоков
+		bool try_expand(pointer p, size_type old_n, size_type new_n) noexcept
 		{
-			::operator delete(p);
+#ifdef MIV_HAS_MMAP
+			if (new_n <= max_size() && is_mapped(old_n))
+				return detail::remap_pages(p, old_n * sizeof(T), new_n * sizeof(T), false) != nullptr;
+#else
+			(void)p, (void)old_n, (void)new_n;
+#endif
+			return false;
+		}
+
+		// Рост блока с побайтовым переносом содержимого: для mmap-блоков страницы
+		// перемапливаются (mremap), а не копируются. Только для trivially relocatable T.
+		pointer reallocate(pointer p, size_type old_n, size_type new_n)
+		{
+#ifdef MIV_HAS_MMAP
+			if (new_n <= max_size() && is_mapped(old_n) && is_mapped(new_n))
+			{
+				if (void *r = detail::remap_pages(p, old_n * sizeof(T), new_n * sizeof(T), true))
+					return static_cast<pointer>(r);
+			}
+#endif
+			pointer np = allocate(new_n);
+			std::memcpy(static_cast<void *>(np), static_cast<const void *>(p), std::min(old_n, new_n) * sizeof(T));
+			deallocate(p, old_n);
+			return np;
 		}
 
 		size_type max_size() const noexcept
@@ -64,86 +236,895 @@ namespace miv
 		{
 			::new ((void *)p) T(std::forward<Args>(args)...);
 		}
-		void destroy(pointer p) noexcept
+		void destroy(pointer p) noexcept
+		{
+			p->~T();
+		}
+
+		bool operator==(const Allocator &) const noexcept { return true; }
+		bool operator!=(const Allocator &) const noexcept { return false; }
+
+	private:
+		static constexpr bool over_aligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+		// mmap отдаёт блоки, выровненные по странице
+		static bool is_mapped(size_type n) noexcept
+		{
+			return alignof(T) <= 4096 && n >= detail::mmap_threshold / sizeof(T);
+		}
+	};
+
+	// Тип можно перемещать побайтовым копированием (memcpy/memmove) без вызова
+	// move-конструктора и деструктора. Для trivially copyable типов выводится
+	// автоматически; для своих типов (например, с std::unique_ptr внутри)
+	// достаточно специализации:
+	//   template <> struct miv::is_trivially_relocatable<MyType> : std::true_type {};
+	template <typename T>
+	struct is_trivially_relocatable : std::is_trivially_copyable<T>
+	{
+	};
+
+	template <typename T>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+	namespace detail
+	{
+		// Рост блока elem средствами аллокатора (try_expand / reallocate), если
+		// он их поддерживает. false - нужен обычный allocate + relocate.
+		template <typename A, typename T>
+		bool expand(A &alloc, T *&elem, std::size_t &space, std::size_t new_cap)
+		{
+			if constexpr (has_try_expand_v<A>)
+			{
+				if (alloc.try_expand(elem, space, new_cap))
+				{
+					space = new_cap;
+					return true;
+				}
+			}
+			if constexpr (has_reallocate_v<A> && is_trivially_relocatable_v<T>)
+			{
+				elem = alloc.reallocate(elem, space, new_cap);
+				space = new_cap;
+				return true;
+			}
+			return false;
+		}
+
+		template <typename It>
+		inline constexpr bool is_forward_iterator_v = std::is_base_of_v<
+			std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+		// Перенос n элементов из src в неинициализированную память dst
+		// (области не пересекаются, src после переноса считается пустым)
+		template <typename A, typename T>
+		void relocate(A &alloc, T *src, std::size_t n, T *dst)
+		{
+			using traits = std::allocator_traits<A>;
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				if (n)
+					std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+			}
+			else
+			{
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					traits::construct(alloc, dst + i, std::move_if_noexcept(src[i]));
+					traits::destroy(alloc, src + i);
+				}
+			}
+		}
+
+		// Сдвиг хвоста [idx, sz) на count позиций вправо; [idx, idx + count)
+		// остаётся неинициализированным.
+		template <typename A, typename T>
+		void shift_right(A &alloc, T *elem, std::size_t sz, std::size_t idx, std::size_t count)
+		{
+			using traits = std::allocator_traits<A>;
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				if (sz > idx)
+					std::memmove(static_cast<void *>(elem + idx + count),
+								 static_cast<const void *>(elem + idx), (sz - idx) * sizeof(T));
+			}
+			else
+			{
+				for (std::size_t i = sz; i > idx; --i)
+				{
+					traits::construct(alloc, elem + i + count - 1, std::move_if_noexcept(elem[i - 1]));
+					traits::destroy(alloc, elem + i - 1);
+				}
+			}
+		}
+
+		// Откат shift_right после исключения: уничтожаем built уже созданных
+		// элементов в дыре и возвращаем хвост на место.
+		template <typename A, typename T>
+		void unshift_right(A &alloc, T *elem, std::size_t &sz, std::size_t idx,
+						   std::size_t count, std::size_t built) noexcept
+		{
+			using traits = std::allocator_traits<A>;
+			for (std::size_t i = 0; i < built; ++i)
+				traits::destroy(alloc, elem + idx + i);
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				if (sz > idx)
+					std::memmove(static_cast<void *>(elem + idx),
+								 static_cast<const void *>(elem + idx + count), (sz - idx) * sizeof(T));
+			}
+			else if constexpr (std::is_nothrow_move_constructible_v<T>)
+			{
+				for (std::size_t i = idx + count; i < sz + count; ++i)
+				{
+					traits::construct(alloc, elem + i - count, std::move(elem[i]));
+					traits::destroy(alloc, elem + i);
+				}
+			}
+			else
+			{
+				// хвост уже перемещён поэлементно; вернуть его без риска исключений нельзя,
+				// поэтому просто уничтожаем его (базовая гарантия)
+				for (std::size_t i = idx + count; i < sz + count; ++i)
+					traits::destroy(alloc, elem + i);
+				sz = idx;
+			}
+		}
+
+		// Сдвиг хвоста [from, sz) на count позиций влево в уже освобождённые
+		// (уничтоженные) слоты.
+		template <typename A, typename T>
+		void shift_left(A &alloc, T *elem, std::size_t sz, std::size_t from, std::size_t count)
+		{
+			using traits = std::allocator_traits<A>;
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				if (sz > from)
+					std::memmove(static_cast<void *>(elem + from - count),
+								 static_cast<const void *>(elem + from), (sz - from) * sizeof(T));
+			}
+			else
+			{
+				for (std::size_t i = from; i < sz; ++i)
+				{
+					traits::construct(alloc, elem + i - count, std::move_if_noexcept(elem[i]));
+					traits::destroy(alloc, elem + i);
+				}
+			}
+		}
+
+		// Перенос n элементов src в dst с дырой из gap слотов в позиции idx.
+		// Сильная гарантия: если перемещение T может бросить, все элементы
+		// сначала копируются, и старые уничтожаются только после успеха; при
+		// исключении dst пуст, src нетронут
+		template <typename A, typename T>
+		void relocate_around(A &alloc, T *src, std::size_t n, std::size_t idx, std::size_t gap, T *dst)
+		{
+			using traits = std::allocator_traits<A>;
+			if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T> ||
+						  !std::is_copy_constructible_v<T>)
+			{
+				relocate(alloc, src, idx, dst);
+				relocate(alloc, src + idx, n - idx, dst + idx + gap);
+			}
+			else
+			{
+				std::size_t i = 0;
+				try
+				{
+					for (; i < n; ++i)
+						traits::construct(alloc, dst + (i < idx ? i : i + gap), std::as_const(src[i]));
+				}
+				catch (...)
+				{
+					for (std::size_t j = 0; j < i; ++j)
+						traits::destroy(alloc, dst + (j < idx ? j : j + gap));
+					throw;
+				}
+				for (i = 0; i < n; ++i)
+					traits::destroy(alloc, src + i);
+			}
+		}
+	}
+
+	// Random-access итератор
+	template <typename T>
+	class VectorIterator
+	{
+	private:
+		template <typename U>
+		friend class VectorIterator;
+		T *ptr_;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T *;
+		using reference = T &;
+
+		constexpr VectorIterator() noexcept : ptr_(nullptr) {}
+		explicit constexpr VectorIterator(T *p) noexcept : ptr_(p) {}
+
+		template <typename U, typename = std::enable_if_t<std::is_convertible_v<U *, T *>>>
+		constexpr VectorIterator(const VectorIterator<U> &other) noexcept
+			: ptr_(other.ptr_)
+		{
+		}
+
+		constexpr reference operator*() const noexcept { return *ptr_; }
+		constexpr pointer operator->() const noexcept { return ptr_; }
+		constexpr reference operator[](difference_type n) const noexcept { return ptr_[n]; }
+
+		constexpr VectorIterator &operator++() noexcept
+		{
+			++ptr_;
+			return *this;
+		}
+		constexpr VectorIterator operator++(int) noexcept
+		{
+			VectorIterator tmp(*this);
+			++ptr_;
+			return tmp;
+		}
+		constexpr VectorIterator &operator--() noexcept
+		{
+			--ptr_;
+			return *this;
+		}
+		constexpr VectorIterator operator--(int) noexcept
+		{
+			VectorIterator tmp(*this);
+			--ptr_;
+			return tmp;
+		}
+
+		constexpr VectorIterator &operator+=(difference_type n) noexcept
+		{
+			ptr_ += n;
+			return *this;
+		}
+		constexpr VectorIterator &operator-=(difference_type n) noexcept
+		{
+			ptr_ -= n;
+			return *this;
+		}
+
+		constexpr VectorIterator operator+(difference_type n) const noexcept { return VectorIterator(ptr_ + n); }
+		friend constexpr VectorIterator operator+(difference_type n, const VectorIterator &it) noexcept { return it + n; }
+		constexpr VectorIterator operator-(difference_type n) const noexcept { return VectorIterator(ptr_ - n); }
+		constexpr difference_type operator-(const VectorIterator &o) const noexcept { return ptr_ - o.ptr_; }
+
+		constexpr bool operator==(const VectorIterator &o) const noexcept { return ptr_ == o.ptr_; }
+		constexpr bool operator!=(const VectorIterator &o) const noexcept { return ptr_ != o.ptr_; }
+		constexpr bool operator<(const VectorIterator &o) const noexcept { return ptr_ < o.ptr_; }
+		constexpr bool operator>(const VectorIterator &o) const noexcept { return ptr_ > o.ptr_; }
+		constexpr bool operator<=(const VectorIterator &o) const noexcept { return ptr_ <= o.ptr_; }
+		constexpr bool operator>=(const VectorIterator &o) const noexcept { return ptr_ >= o.ptr_; }
+	};
+
+	// Тип можно сравнивать на равенство побайтово (memcmp). Выводится для
+	// целых, перечислений и указателей; для своих POD без паддинга, у которых
+	// operator== сравнивает все поля, достаточно специализации:
+	//   template <> struct miv::is_bitwise_comparable<MyPod> : std::true_type {};
+	template <typename T>
+	struct is_bitwise_comparable
+		: std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>
+	{
+	};
+
+	template <typename T>
+	inline constexpr bool is_bitwise_comparable_v = is_bitwise_comparable<T>::value;
+
+	namespace detail
+	{
+		template <typename A, typename = void>
+		struct has_construct : std::false_type
+		{
+		};
+		template <typename A>
+		struct has_construct<A, std::void_t<decltype(std::declval<A &>().construct(
+									std::declval<typename std::allocator_traits<A>::pointer>(),
+									std::declval<const typename std::allocator_traits<A>::value_type &>()))>>
+			: std::true_type
+		{
+		};
+
+		// construct аллокатора - обычный placement new (своего construct нет,
+		// либо это std::allocator / miv::Allocator), значит элементы можно
+		// создавать копированием байт
+		template <typename A>
+		struct plain_construct : std::bool_constant<!has_construct<A>::value>
+		{
+		};
+		template <typename U>
+		struct plain_construct<std::allocator<U>> : std::true_type
+		{
+		};
+		template <typename U>
+		struct plain_construct<Allocator<U>> : std::true_type
+		{
+		};
+
+		template <typename T, typename A>
+		inline constexpr bool bytewise_construct_v = std::is_trivially_copyable_v<T> && plain_construct<A>::value;
+
+		// memcmp упорядочивает как operator<: беззнаковые однобайтовые типы
+		template <typename T>
+		inline constexpr bool bytewise_less_v = std::is_same_v<T, unsigned char> || std::is_same_v<T, std::byte> ||
+											   (std::is_same_v<T, char> && !std::is_signed_v<char>);
+
+		// Итераторы, которые разворачиваются в указатель на непрерывный массив
+		template <typename It>
+		struct is_contiguous_iterator : std::is_pointer<It>
+		{
+		};
+		template <typename U>
+		struct is_contiguous_iterator<VectorIterator<U>> : std::true_type
+		{
+		};
+
+		template <typename It>
+		auto to_pointer(It it) noexcept
+		{
+			if constexpr (std::is_pointer_v<It>)
+				return it;
+			else
+				return it.operator->();
+		}
+
+		template <typename T>
+		bool all_zero_bytes(const T &value) noexcept
+		{
+			unsigned char bytes[sizeof(T)];
+			std::memcpy(bytes, &value, sizeof(T));
+			for (unsigned char b : bytes)
+				if (b)
+					return false;
+			return true;
+		}
+
+		// Копии в неинициализированную память dst; при исключении уже
+		// созданные уничтожаются. Для тривиально копируемых T - memset,
+		// если значение однобайтовое или из нулевых байт
+		template <typename A, typename T>
+		void construct_n(A &alloc, T *dst, std::size_t count, const T &value)
+		{
+			using traits = std::allocator_traits<A>;
+			if constexpr (bytewise_construct_v<T, A>)
+			{
+				if (count == 0)
+					return;
+				if constexpr (sizeof(T) == 1)
+				{
+					unsigned char b;
+					std::memcpy(&b, &value, 1);
+					std::memset(static_cast<void *>(dst), b, count);
+				}
+				else if (all_zero_bytes(value))
+					std::memset(static_cast<void *>(dst), 0, count * sizeof(T));
+				else
+					std::uninitialized_fill_n(dst, count, value);
+			}
+			else
+			{
+				std::size_t i = 0;
+				try
+				{
+					for (; i < count; ++i)
+						traits::construct(alloc, dst + i, value);
+				}
+				catch (...)
+				{
+					for (std::size_t j = 0; j < i; ++j)
+						traits::destroy(alloc, dst + j);
+					throw;
+				}
+			}
+		}
+
+		// Копирование [first, last) в неинициализированную память dst; из
+		// непрерывного диапазона тех же тривиально копируемых T - memcpy
+		template <typename A, typename T, typename It>
+		void construct_range(A &alloc, T *dst, It first, It last)
+		{
+			using traits = std::allocator_traits<A>;
+			if constexpr (bytewise_construct_v<T, A> && is_contiguous_iterator<It>::value &&
+						  std::is_same_v<std::remove_cv_t<typename std::iterator_traits<It>::value_type>, T>)
+			{
+				if (first != last)
+					std::memcpy(static_cast<void *>(dst), static_cast<const void *>(to_pointer(first)),
+								static_cast<std::size_t>(last - first) * sizeof(T));
+			}
+			else if constexpr (bytewise_construct_v<T, A> && std::is_nothrow_constructible_v<T, decltype(*first)>)
+			{
+				// std::uninitialized_copy сам сводит непрерывные итераторы
+				// стандартной библиотеки к memmove
+				std::uninitialized_copy(first, last, dst);
+			}
+			else
+			{
+				T *p = dst;
+				try
+				{
+					for (; first != last; ++first, ++p)
+						traits::construct(alloc, p, *first);
+				}
+				catch (...)
+				{
+					for (T *q = dst; q != p; ++q)
+						traits::destroy(alloc, q);
+					throw;
+				}
+			}
+		}
+	}
+
+	// Random-access итератор по индексу для контейнеров с несмежным хранением
+	template <typename C, typename T>
+	class SegmentIterator
+	{
+	private:
+		template <typename, typename>
+		friend class SegmentIterator;
+		C *owner_;
+		std::size_t idx_;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::remove_const_t<T>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T *;
+		using reference = T &;
+
+		SegmentIterator() noexcept : owner_(nullptr), idx_(0) {}
+		SegmentIterator(C *owner, std::size_t idx) noexcept : owner_(owner), idx_(idx) {}
+
+		template <typename D, typename U, typename = std::enable_if_t<std::is_convertible_v<U *, T *>>>
+		SegmentIterator(const SegmentIterator<D, U> &other) noexcept
+			: owner_(other.owner_), idx_(other.idx_)
+		{
+		}
+
+		reference operator*() const noexcept { return (*owner_)[idx_]; }
+		pointer operator->() const noexcept { return &(*owner_)[idx_]; }
+		reference operator[](difference_type n) const noexcept { return (*owner_)[idx_ + n]; }
+
+		SegmentIterator &operator++() noexcept
+		{
+			++idx_;
+			return *this;
+		}
+		SegmentIterator operator++(int) noexcept
+		{
+			SegmentIterator tmp(*this);
+			++idx_;
+			return tmp;
+		}
+		SegmentIterator &operator--() noexcept
+		{
+			--idx_;
+			return *this;
+		}
+		SegmentIterator operator--(int) noexcept
+		{
+			SegmentIterator tmp(*this);
+			--idx_;
+			return tmp;
+		}
+		SegmentIterator &operator+=(difference_type n) noexcept
+		{
+			idx_ += n;
+			return *this;
+		}
+		SegmentIterator &operator-=(difference_type n) noexcept
+		{
+			idx_ -= n;
+			return *this;
+		}
+
+		SegmentIterator operator+(difference_type n) const noexcept { return SegmentIterator(owner_, idx_ + n); }
+		friend SegmentIterator operator+(difference_type n, const SegmentIterator &it) noexcept { return it + n; }
+		SegmentIterator operator-(difference_type n) const noexcept { return SegmentIterator(owner_, idx_ - n); }
+		difference_type operator-(const SegmentIterator &o) const noexcept
+		{
+			return static_cast<difference_type>(idx_) - static_cast<difference_type>(o.idx_);
+		}
+
+		bool operator==(const SegmentIterator &o) const noexcept { return idx_ == o.idx_; }
+		bool operator!=(const SegmentIterator &o) const noexcept { return idx_ != o.idx_; }
+		bool operator<(const SegmentIterator &o) const noexcept { return idx_ < o.idx_; }
+		bool operator>(const SegmentIterator &o) const noexcept { return idx_ > o.idx_; }
+		bool operator<=(const SegmentIterator &o) const noexcept { return idx_ <= o.idx_; }
+		bool operator>=(const SegmentIterator &o) const noexcept { return idx_ >= o.idx_; }
+	};
+
+	namespace detail
+	{
+		// cap * Num / Den без переполнения, не меньше need
+		template <std::size_t Num, std::size_t Den>
+		std::size_t scale_capacity(std::size_t cap, std::size_t need) noexcept
+		{
+			std::size_t limit = std::numeric_limits<std::size_t>::max();
+			std::size_t grown = cap > limit / Num ? limit : cap * Num / Den;
+			return std::max(grown, need);
+		}
+
+		inline std::size_t os_page_size() noexcept
+		{
+#ifdef MIV_HAS_MMAP
+			return page_size();
+#else
+			return 4096;
+#endif
+		}
+
+		// Размерные классы malloc (как у jemalloc/tcmalloc): 4 класса на каждое
+		// удвоение с шагом не меньше 16 байт. Блоки от mmap_threshold Allocator
+		// берёт страницами, для них класс - целые страницы.
+		inline std::size_t size_class(std::size_t bytes) noexcept
+		{
+			if (bytes <= 16)
+				return 16;
+			if (bytes >= mmap_threshold)
+			{
+				std::size_t ps = os_page_size();
+				return (bytes + ps - 1) / ps * ps;
+			}
+			std::size_t lg = std::numeric_limits<std::size_t>::digits - 1;
+			while (!((bytes - 1) >> lg))
+				--lg;
+			std::size_t step = std::max<std::size_t>(std::size_t(1) << (lg - 2), 16);
+			return (bytes + step - 1) / step * step;
+		}
+
+		// Ёмкость, занимающая rounded(cap * size) байт целиком
+		inline std::size_t fill_bytes(std::size_t cap, std::size_t elem_size, std::size_t rounded) noexcept
+		{
+			return std::max(cap, rounded / elem_size);
+		}
+	}
+
+	// Политики роста Vector: grow(cap, need, elem_size) возвращает новую
+	// ёмкость не меньше need; при cap == 0 - не меньше Initial.
+	// Вызываются только когда need > cap.
+
+	// Удвоение: меньше всего переаллокаций, до 50% свободного места
+	template <std::size_t Initial = 8>
+	struct DoublingGrowth
+	{
+		static constexpr std::size_t initial = Initial;
+		static std::size_t grow(std::size_t cap, std::size_t need, std::size_t) noexcept
+		{
+			return cap == 0 ? std::max(need, Initial) : detail::scale_capacity<2, 1>(cap, need);
+		}
+	};
+
+	// 1.5x: освобождённые блоки со временем подходят для повторного использования
+	template <std::size_t Initial = 8>
+	struct OneAndHalfGrowth
+	{
+		static constexpr std::size_t initial = Initial;
+		static std::size_t grow(std::size_t cap, std::size_t need, std::size_t) noexcept
+		{
+			return cap == 0 ? std::max(need, Initial) : detail::scale_capacity<3, 2>(cap, need);
+		}
+	};
+
+	// 1.5x с округлением вверх до размерного класса аллокатора: хвост блока,
+	// который malloc всё равно выделит, становится ёмкостью
+	template <std::size_t Initial = 8>
+	struct SizeClassGrowth
+	{
+		static constexpr std::size_t initial = Initial;
+		static std::size_t grow(std::size_t cap, std::size_t need, std::size_t elem_size) noexcept
+		{
+			std::size_t n = cap == 0 ? std::max(need, Initial) : detail::scale_capacity<3, 2>(cap, need);
+			if (n > std::numeric_limits<std::size_t>::max() / 2 / elem_size)
+				return n;
+			return detail::fill_bytes(n, elem_size, detail::size_class(n * elem_size));
+		}
+	};
+
+	// Удвоение с округлением до целых страниц: для больших векторов на
+	// mmap-блоках, где частичная последняя страница - чистые потери
+	template <std::size_t Initial = 8>
+	struct PageGrowth
+	{
+		static constexpr std::size_t initial = Initial;
+		static std::size_t grow(std::size_t cap, std::size_t need, std::size_t elem_size) noexcept
+		{
+			std::size_t n = cap == 0 ? std::max(need, Initial) : detail::scale_capacity<2, 1>(cap, need);
+			if (n > std::numeric_limits<std::size_t>::max() / 2 / elem_size)
+				return n;
+			std::size_t ps = detail::os_page_size();
+			return detail::fill_bytes(n, elem_size, (n * elem_size + ps - 1) / ps * ps);
+		}
+	};
+
+	// Откуда пришла переаллокация: явный reserve (и resize/assign), рост при
+	// добавлении в конец или при вставке в середину
+	enum class ReallocReason : std::uint8_t
+	{
+		reserve = 0,
+		push_back = 1,
+		insert = 2,
+	};
+
+	// Политика статистики Vector: статические хуки на каждое выделение,
+	// освобождение и перенос буфера (размеры в байтах). NoStats - пустые
+	// inline-функции, после оптимизации от них ничего не остаётся; счётчики
+	// по местам использования - Stats<Tag> из Stats.h.
+	struct NoStats
+	{
+		static void on_allocate(std::size_t) noexcept {}
+		// slack - неиспользованная часть освобождаемого блока
+		static void on_deallocate(std::size_t, std::size_t) noexcept {}
+		// relocated - сколько элементов переехало (0 при росте на месте)
+		static void on_reallocate(ReallocReason, std::size_t, std::size_t, std::size_t) noexcept {}
+	};
+
+	// Метка конструктора Vector(from_pool, hint): начать с буфера из CapacityPool
+	struct from_pool_t
+	{
+		explicit from_pool_t() = default;
+	};
+	inline constexpr from_pool_t from_pool{};
+
+	namespace detail
+	{
+		inline unsigned floor_log2(std::uint64_t v) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#else
+			unsigned k = 0;
+			while (v >>= 1)
+				++k;
+			return k;
+#endif
+		}
+
+		// Сколько байт удерживают пулы потока и сколько можно
+		struct PoolBudget
+		{
+			std::size_t retained = 0;
+			std::size_t limit = std::size_t(4) << 20;
+		};
+
+		inline PoolBudget &pool_budget() noexcept
+		{
+			static thread_local PoolBudget budget;
+			return budget;
+		}
+
+		// Пулы потока в одном списке, чтобы trim_capacity_pools() обошёл все типы
+		class CapacityPoolBase
+		{
+		public:
+			CapacityPoolBase(const CapacityPoolBase &) = delete;
+			CapacityPoolBase &operator=(const CapacityPoolBase &) = delete;
+
+			static void trim_all() noexcept
+			{
+				for (CapacityPoolBase *p = head(); p; p = p->next_)
+					p->trim();
+			}
+
+			virtual void trim() noexcept = 0;
+
+		protected:
+			CapacityPoolBase() noexcept : next_(head()) { head() = this; }
+
+			~CapacityPoolBase()
+			{
+				CapacityPoolBase **p = &head();
+				while (*p != this)
+					p = &(*p)->next_;
+				*p = next_;
+			}
+
+		private:
+			CapacityPoolBase *next_;
+
+			static CapacityPoolBase *&head() noexcept
+			{
+				static thread_local CapacityPoolBase *list = nullptr;
+				return list;
+			}
+		};
+	}
+
+	// Лимит памяти, которую держат пулы ёмкости потока (по умолчанию 4 MiB).
+	// Уменьшение не освобождает уже отложенное - для этого trim_capacity_pools()
+	inline void set_capacity_pool_limit(std::size_t bytes) noexcept { detail::pool_budget().limit = bytes; }
+	inline std::size_t capacity_pool_limit() noexcept { return detail::pool_budget().limit; }
+	inline std::size_t capacity_pool_retained() noexcept { return detail::pool_budget().retained; }
+	inline void trim_capacity_pools() noexcept { detail::CapacityPoolBase::trim_all(); }
+
+	// CapacityPool<T, A>: буферы, возвращённые Vector<T, A> в этом потоке,
+	// для следующих векторов того же типа. Блоки лежат по классам ёмкости
+	// [2^k, 2^(k+1)), не больше blocks_per_class в классе; сверх лимита
+	// потока блок сразу уходит аллокатору. Только для аллокаторов без
+	// состояния (is_always_equal): блок освобождает любой экземпляр A.
+	template <typename T, typename A>
+	class CapacityPool : private detail::CapacityPoolBase
+	{
+		using alloc_traits = std::allocator_traits<A>;
+		static_assert(alloc_traits::is_always_equal::value, "CapacityPool requires a stateless allocator");
+
+	public:
+		using pointer = T *;
+		using size_type = std::size_t;
+
+		static constexpr size_type blocks_per_class = 4;
+		// Блок берётся из класса не более чем на 2 старше запроса: его ёмкость
+		// меньше 8 * hint
+		static constexpr unsigned max_oversize_classes = 2;
+
+		// Пул потока; nullptr, если поток уже завершается и пул разрушен
+		static CapacityPool *local() noexcept
+		{
+			static thread_local bool dead = false;
+			if (dead)
+				return nullptr;
+			static thread_local CapacityPool pool(dead);
+			return &pool;
+		}
+
+		// Вернуть блок в пул потока или аллокатору
+		static void recycle(pointer p, size_type n) noexcept
+		{
+			if (CapacityPool *pool = local())
+				pool->release(p, n);
+			else
+			{
+				A alloc;
+				alloc_traits::deallocate(alloc, p, n);
+			}
+		}
+
+		// Блок ёмкостью не меньше hint (в cap - его ёмкость); hint == 0 -
+		// блок того класса, что возвращали последним. nullptr - подходящего нет
+		pointer acquire(size_type hint, size_type &cap) noexcept
+		{
+			if (hint == 0)
+				return take(last_, 0, cap);
+			unsigned c = class_of(hint);
+			if (pointer p = take(c, hint, cap))
+				return p;
+			for (unsigned k = c + 1; k <= c + max_oversize_classes && k < classes; ++k)
+				if (pointer p = take(k, 0, cap))
+					return p;
+			return nullptr;
+		}
+
+		// Блок ёмкостью ровно n - для RecyclingAllocator
+		pointer acquire_exact(size_type n) noexcept
+		{
+			Class &cl = classes_[class_of(n)];
+			for (unsigned i = cl.count; i-- > 0;)
+				if (cl.blocks[i].cap == n)
+					return remove(cl, i).p;
+			return nullptr;
+		}
+
+		void release(pointer p, size_type n) noexcept
+		{
+			if (!p)
+				return;
+			detail::PoolBudget &budget = detail::pool_budget();
+			unsigned c = class_of(n);
+			Class &cl = classes_[c];
+			if (n && cl.count < blocks_per_class && n <= budget.limit / sizeof(T) &&
+				budget.retained + n * sizeof(T) <= budget.limit)
+			{
+				cl.blocks[cl.count++] = Block{ p, n };
+				budget.retained += n * sizeof(T);
+				bytes_ += n * sizeof(T);
+				last_ = c;
+				return;
+			}
+			alloc_traits::deallocate(alloc_, p, n);
+		}
+
+		// Отдать все блоки аллокатору
+		void trim() noexcept override
 		{
-			p->~T();
+			for (Class &cl : classes_)
+				while (cl.count)
+				{
+					Block b = remove(cl, cl.count - 1);
+					alloc_traits::deallocate(alloc_, b.p, b.cap);
+				}
 		}
 
-		bool operator==(const Allocator &) const noexcept { return true; }
-		bool operator!=(const Allocator &) const noexcept { return false; }
-	};
+		// Байт в блоках этого пула
+		size_type retained() const noexcept { return bytes_; }
 
-	// Random-access итератор
-	template <typename T>
-	class VectorIterator
-	{
 	private:
-		template <typename U>
-		friend class VectorIterator;
-		T *ptr_;
+		struct Block
+		{
+			pointer p;
+			size_type cap;
+		};
+		struct Class
+		{
+			Block blocks[blocks_per_class];
+			unsigned count = 0;
+		};
 
-	public:
-		using iterator_category = std::random_access_iterator_tag;
-		using value_type = T;
-		using difference_type = std::ptrdiff_t;
-		using pointer = T *;
-		using reference = T &;
+		static constexpr unsigned classes = std::numeric_limits<size_type>::digits;
 
-		VectorIterator() noexcept : ptr_(nullptr) {}
-		explicit VectorIterator(T *p) noexcept : ptr_(p) {}
+		A alloc_;
+		Class classes_[classes];
+		size_type bytes_ = 0;
+		unsigned last_ = 0;
+		bool &dead_;
 
-		template <typename U, typename = std::enable_if_t<std::is_convertible_v<U *, T *>>>
-		VectorIterator(const VectorIterator<U> &other) noexcept
-			: ptr_(other.ptr_)
+		explicit CapacityPool(bool &dead) noexcept : dead_(dead) {}
+
+		~CapacityPool()
 		{
+			trim();
+			dead_ = true;
 		}
 
-		constexpr reference operator*() const noexcept { return *ptr_; }
-		constexpr pointer operator->() const noexcept { return ptr_; }
-		constexpr reference operator[](difference_type n) const noexcept { return ptr_[n]; }
+		static unsigned class_of(size_type n) noexcept { return n ? detail::floor_log2(n) : 0; }
 
-		constexpr VectorIterator &operator++() noexcept
+		// Последний положенный блок класса c с ёмкостью >= need
+		pointer take(unsigned c, size_type need, size_type &cap) noexcept
 		{
-			++ptr_;
-			return *this;
+			Class &cl = classes_[c];
+			for (unsigned i = cl.count; i-- > 0;)
+				if (cl.blocks[i].cap >= need)
+				{
+					Block b = remove(cl, i);
+					cap = b.cap;
+					return b.p;
+				}
+			return nullptr;
 		}
-		constexpr VectorIterator operator++(int) noexcept
+
+		Block remove(Class &cl, unsigned i) noexcept
 		{
-			VectorIterator tmp(*this);
-			++ptr_;
-			return tmp;
+			Block b = cl.blocks[i];
+			cl.blocks[i] = cl.blocks[--cl.count];
+			bytes_ -= b.cap * sizeof(T);
+			detail::pool_budget().retained -= b.cap * sizeof(T);
+			return b;
 		}
-		VectorIterator &operator--() noexcept
+	};
+
+	namespace detail
+	{
+		// Пул, в который Vector<T, A> сдаёт буферы: аллокатор-обёртка над
+		// пулом (RecyclingAllocator) объявляет pool_upstream, и блоки лежат в
+		// пуле нижележащего аллокатора
+		template <typename A, typename = void>
+		struct pool_allocator
 		{
-			--ptr_;
-			return *this;
-		}
-		VectorIterator operator--(int) noexcept
+			using type = A;
+		};
+		template <typename A>
+		struct pool_allocator<A, std::void_t<typename A::pool_upstream>>
 		{
-			VectorIterator tmp(*this);
-			--ptr_;
-			return tmp;
-		}
-
-		constexpr VectorIterator operator+(difference_type n) const noexcept { return VectorIterator(ptr_ + n); }
-		VectorIterator operator-(difference_type n) const noexcept { return VectorIterator(ptr_ - n); }
-		constexpr difference_type operator-(const VectorIterator &o) const noexcept { return ptr_ - o.ptr_; }
+			using type = typename A::pool_upstream;
+		};
+	}
 
-		bool operator==(const VectorIterator &o) const noexcept { return ptr_ == o.ptr_; }
-		bool operator!=(const VectorIterator &o) const noexcept { return ptr_ != o.ptr_; }
-		bool operator<(const VectorIterator &o) const noexcept { return ptr_ < o.ptr_; }
-		bool operator>(const VectorIterator &o) const noexcept { return ptr_ > o.ptr_; }
-		bool operator<=(const VectorIterator &o) const noexcept { return ptr_ <= o.ptr_; }
-		bool operator>=(const VectorIterator &o) const noexcept { return ptr_ >= o.ptr_; }
-	};
+	template <typename T, typename A>
+	using capacity_pool_for = CapacityPool<T, typename detail::pool_allocator<A>::type>;
 
 	// Основная реализация vector<T>
-	template <typename T, typename A = Allocator<T>>
+	template <typename T, typename A = Allocator<T>, typename G = DoublingGrowth<>, typename S = NoStats>
 	class Vector
 	{
 	public:
 		using value_type = T;
 		using allocator_type = A;
+		using growth_policy = G;
+		using stats_policy = S;
 		using size_type = std::size_t;
 		using difference_type = std::ptrdiff_t;
 		using reference = T &;
@@ -163,9 +1144,18 @@ namespace miv
 
 		explicit Vector(size_type n, const T &value = T(),
 						const allocator_type &alloc = allocator_type())
-			: alloc_(alloc), elem_(alloc_traits::allocate(alloc_, n)), sz_(n), space_(n)
+			: alloc_(alloc), elem_(allocate_storage(n)), sz_(0), space_(n)
 		{
-			std::uninitialized_fill(elem_, elem_ + n, value);
+			try
+			{
+				detail::construct_n(alloc_, elem_, n, value);
+			}
+			catch (...)
+			{
+				deallocate_storage(elem_, n, 0);
+				throw;
+			}
+			sz_ = n;
 		}
 
 		template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
@@ -173,8 +1163,7 @@ namespace miv
 			   const allocator_type &alloc = allocator_type())
 			: alloc_(alloc), elem_(nullptr), sz_(0), space_(0)
 		{
-			for (; first != last; ++first)
-				push_back(*first);
+			append_range(first, last);
 		}
 
 		Vector(std::initializer_list<T> il,
@@ -183,10 +1172,26 @@ namespace miv
 		{
 		}
 
+		// Пустой вектор на буфере из CapacityPool потока (см. acquire_from_pool)
+		Vector(from_pool_t, size_type hint = 0, const allocator_type &alloc = allocator_type())
+			: Vector(alloc)
+		{
+			acquire_from_pool(hint);
+		}
+
 		Vector(const Vector &other)
-			: alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_)), elem_(alloc_traits::allocate(alloc_, other.sz_)), sz_(other.sz_), space_(other.sz_)
+			: alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_)), elem_(allocate_storage(other.sz_)), sz_(0), space_(other.sz_)
 		{
-			std::uninitialized_copy(other.elem_, other.elem_ + sz_, elem_);
+			try
+			{
+				detail::construct_range(alloc_, elem_, other.elem_, other.elem_ + other.sz_);
+			}
+			catch (...)
+			{
+				deallocate_storage(elem_, space_, 0);
+				throw;
+			}
+			sz_ = other.sz_;
 		}
 
 		Vector(Vector &&other) noexcept
@@ -202,27 +1207,47 @@ namespace miv
 				return *this;
 			if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
 			{
+				// старый буфер освобождается тем аллокатором, которым был выделен
 				if (alloc_ != other.alloc_)
+				{
+					release_storage();
 					alloc_ = other.alloc_;
+				}
 			}
-			Vector tmp(other);
-			swap(tmp);
+			Vector tmp(alloc_);
+			tmp.reserve(other.sz_);
+			detail::construct_range(alloc_, tmp.elem_, other.elem_, other.elem_ + other.sz_);
+			tmp.sz_ = other.sz_;
+			swap_storage(tmp);
 			return *this;
 		}
 
 		Vector &operator=(Vector &&other) noexcept(
-			alloc_traits::propagate_on_container_move_assignment::value)
+			alloc_traits::propagate_on_container_move_assignment::value ||
+			alloc_traits::is_always_equal::value)
 		{
-			clear();
+			if (this == &other)
+				return *this;
 			if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
 			{
+				release_storage();
 				alloc_ = std::move(other.alloc_);
+				swap_storage(other);
+			}
+			else
+			{
+				if (alloc_ == other.alloc_)
+				{
+					release_storage();
+					swap_storage(other);
+				}
+				else
+				{
+					// чужой аллокатор без propagate: буфер забрать нельзя, переносим поэлементно
+					assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+					other.clear();
+				}
 			}
-			elem_ = other.elem_;
-			sz_ = other.sz_;
-			space_ = other.space_;
-			other.elem_ = nullptr;
-			other.sz_ = other.space_ = 0;
 			return *this;
 		}
 
@@ -232,19 +1257,8 @@ namespace miv
 
 		void reserve(size_type new_cap)
 		{
-			if (new_cap <= space_)
-				return;
-			pointer new_elem = alloc_traits::allocate(alloc_, new_cap);
-			for (size_type i = 0; i < sz_; ++i)
-			{
-				alloc_traits::construct(alloc_, new_elem + i,
-										std::move_if_noexcept(elem_[i]));
-				alloc_traits::destroy(alloc_, elem_ + i);
-			}
-			if (elem_)
-				alloc_traits::deallocate(alloc_, elem_, space_);
-			elem_ = new_elem;
-			space_ = new_cap;
+			if (new_cap > space_)
+				reallocate(new_cap, ReallocReason::reserve);
 		}
 
 		void shrink_to_fit()
@@ -253,6 +1267,56 @@ namespace miv
 				reserve(sz_);
 		}
 
+		// Уничтожить элементы и сдать буфер в CapacityPool потока; ёмкость
+		// становится 0. Следующий вектор того же типа начнёт с этого буфера
+		// через from_pool, без роста 8 -> 16 -> ... и копирований
+		void release_to_pool() noexcept
+		{
+			size_type used = sz_;
+			clear();
+			if (elem_)
+			{
+				S::on_deallocate(space_ * sizeof(T), (space_ - used) * sizeof(T));
+				capacity_pool_for<T, A>::recycle(elem_, space_);
+				elem_ = nullptr;
+				space_ = 0;
+			}
+		}
+
+		// Перейти на буфер из пула ёмкостью не меньше hint (меньше 8 * hint);
+		// hint == 0 - буфер того класса, что сдавали последним, если ёмкости
+		// ещё нет. Подходящего в пуле нет - обычный reserve(hint)
+		void acquire_from_pool(size_type hint = 0)
+		{
+			if (hint ? hint <= space_ : space_ != 0)
+				return;
+			size_type cap = 0;
+			pointer p = nullptr;
+			if (auto *pool = capacity_pool_for<T, A>::local())
+				p = pool->acquire(hint, cap);
+			if (!p)
+				return reserve(hint);
+			S::on_allocate(cap * sizeof(T));
+			try
+			{
+				detail::relocate_around(alloc_, elem_, sz_, sz_, 0, p);
+			}
+			catch (...)
+			{
+				S::on_deallocate(cap * sizeof(T), cap * sizeof(T));
+				capacity_pool_for<T, A>::recycle(p, cap);
+				throw;
+			}
+			if (elem_)
+			{
+				S::on_deallocate(space_ * sizeof(T), (space_ - sz_) * sizeof(T));
+				S::on_reallocate(ReallocReason::reserve, space_ * sizeof(T), cap * sizeof(T), sz_);
+				capacity_pool_for<T, A>::recycle(elem_, space_);
+			}
+			elem_ = p;
+			space_ = cap;
+		}
+
 		// Модификаторы
 		void clear() noexcept
 		{
@@ -262,6 +1326,27 @@ namespace miv
 		}
 
 		void resize(size_type count, const T &value = T())
+		{
+			if (count < sz_)
+			{
+				for (size_type i = count; i < sz_; ++i)
+					alloc_traits::destroy(alloc_, elem_ + i);
+			}
+			else if (count > sz_)
+			{
+				// value может ссылаться на элемент: при росте копии строятся
+				// в новом блоке до переноса старых
+				if (count <= space_ ||
+					!grow_insert(sz_, count - sz_, ReallocReason::reserve,
+								 [&](pointer p) { detail::construct_n(alloc_, p, count - sz_, value); }))
+					detail::construct_n(alloc_, elem_ + sz_, count - sz_, value);
+			}
+			sz_ = count;
+		}
+
+		// Рост без value-инициализации: новые элементы default-initialized,
+		// для тривиальных T память не обнуляется
+		void resize_default_init(size_type count)
 		{
 			if (count < sz_)
 			{
@@ -271,40 +1356,77 @@ namespace miv
 			else
 			{
 				reserve(count);
-				for (size_type i = sz_; i < count; ++i)
-					alloc_traits::construct(alloc_, elem_ + i, value);
+				size_type i = sz_;
+				try
+				{
+					for (; i < count; ++i)
+						::new (static_cast<void *>(elem_ + i)) T;
+				}
+				catch (...)
+				{
+					for (size_type j = sz_; j < i; ++j)
+						alloc_traits::destroy(alloc_, elem_ + j);
+					throw;
+				}
 			}
 			sz_ = count;
 		}
 
+		// Как std::string::resize_and_overwrite: op(data(), count) заполняет буфер
+		// напрямую (хвост [size(), count) не инициализирован) и возвращает новый
+		// размер, не больше count
+		template <typename Op>
+		void resize_and_overwrite(size_type count, Op op)
+		{
+			static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+						  "resize_and_overwrite requires a trivial element type");
+			reserve(count);
+			sz_ = static_cast<size_type>(op(elem_, count));
+		}
+
+		// Добавление диапазона в конец; для forward-итераторов буфер
+		// расширяется один раз
+		template <typename InputIt,
+				  typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		void append_range(InputIt first, InputIt last)
+		{
+			if constexpr (detail::is_forward_iterator_v<InputIt>)
+			{
+				size_type count = static_cast<size_type>(std::distance(first, last));
+				if (sz_ + count > space_)
+					reallocate(next_capacity(sz_ + count), ReallocReason::push_back);
+				detail::construct_range(alloc_, elem_ + sz_, first, last);
+				sz_ += count;
+			}
+			else
+			{
+				for (; first != last; ++first)
+					emplace_back(*first);
+			}
+		}
+
 		void push_back(const T &v)
 		{
-			if (space_ == 0)
-				reserve(8);
-			else if (sz_ == space_)
-				reserve(2 * space_);
-			alloc_traits::construct(alloc_, elem_ + sz_, v);
-			++sz_;
+			emplace_back(v);
 		}
 		void push_back(T &&v)
 		{
-			if (space_ == 0)
-				reserve(8);
-			else if (sz_ == space_)
-				reserve(2 * space_);
-			alloc_traits::construct(alloc_, elem_ + sz_, std::move(v));
-			++sz_;
+			emplace_back(std::move(v));
 		}
 
+		// v.push_back(v[0]) при полном буфере корректен: новый элемент
+		// создаётся до переноса старых (см. grow_emplace)
 		template <typename... Args>
 		reference emplace_back(Args &&...args)
 		{
-			if (space_ == 0)
-				reserve(8);
-			else if (sz_ == space_)
-				reserve(2 * space_);
-			alloc_traits::construct(alloc_, elem_ + sz_, std::forward<Args>(args)...);
-			return elem_[sz_++];
+			if (sz_ == space_)
+				grow_emplace(sz_, ReallocReason::push_back, std::forward<Args>(args)...);
+			else
+			{
+				alloc_traits::construct(alloc_, elem_ + sz_, std::forward<Args>(args)...);
+				++sz_;
+			}
+			return elem_[sz_ - 1];
 		}
 
 		void pop_back() noexcept
@@ -314,13 +1436,28 @@ namespace miv
 		}
 
 		// assign
+		// value может быть элементом самого вектора, поэтому живые элементы
+		// не уничтожаются до того, как скопированы новые
 		void assign(size_type count, const T &value)
 		{
-			clear();
-			reserve(count);
-			for (size_type i = 0; i < count; ++i)
-				alloc_traits::construct(alloc_, elem_ + i, value);
-			sz_ = count;
+			if (count > space_)
+			{
+				Vector tmp(count, value, alloc_);
+				swap_storage(tmp);
+			}
+			else if (count > sz_)
+			{
+				std::fill(elem_, elem_ + sz_, value);
+				detail::construct_n(alloc_, elem_ + sz_, count - sz_, value);
+				sz_ = count;
+			}
+			else
+			{
+				std::fill_n(elem_, count, value);
+				for (size_type i = count; i < sz_; ++i)
+					alloc_traits::destroy(alloc_, elem_ + i);
+				sz_ = count;
+			}
 		}
 
 		template <typename InputIt,
@@ -328,8 +1465,9 @@ namespace miv
 		void assign(InputIt first, InputIt last)
 		{
 			clear();
-			for (; first != last; ++first)
-				push_back(*first);
+			if constexpr (detail::is_forward_iterator_v<InputIt>)
+				reserve(static_cast<size_type>(std::distance(first, last)));
+			append_range(first, last);
 		}
 
 		void assign(std::initializer_list<T> il)
@@ -338,25 +1476,64 @@ namespace miv
 		}
 
 		// insert - emplace - erase
+		// Хвост сдвигается переносом (memmove или move + destroy), если
+		// перенос не бросает исключений. Иначе - move-присваиванием по живым
+		// элементам (std::move_backward / std::move) с конструированием только
+		// слотов за старым концом: исключение посреди сдвига не теряет
+		// элементы. Значение, которое может ссылаться на элемент самого
+		// вектора, копируется до сдвига
 		iterator insert(const_iterator pos, const T &value)
 		{
 			return emplace(pos, value);
 		}
+		iterator insert(const_iterator pos, T &&value)
+		{
+			return emplace(pos, std::move(value));
+		}
 
 		iterator insert(const_iterator pos, size_type count, const T &value)
 		{
 			size_type idx = pos - begin();
-			if (sz_ + count > space_)
-				reserve(std::max(space_ * 2, sz_ + count));
-			for (size_type i = sz_; i > idx; --i)
+			if (count == 0)
+				return iterator(elem_ + idx);
+			if (sz_ + count > space_ &&
+				grow_insert(idx, count, ReallocReason::insert,
+							[&](pointer p) { detail::construct_n(alloc_, p, count, value); }))
+				return iterator(elem_ + idx);
+			T tmp(value);
+			if constexpr (nothrow_shift)
 			{
-				alloc_traits::construct(alloc_, elem_ + i + count - 1,
-										std::move_if_noexcept(elem_[i - 1]));
-				alloc_traits::destroy(alloc_, elem_ + i - 1);
+				detail::shift_right(alloc_, elem_, sz_, idx, count);
+				size_type i = 0;
+				try
+				{
+					for (; i < count; ++i)
+						alloc_traits::construct(alloc_, elem_ + idx + i, tmp);
+				}
+				catch (...)
+				{
+					detail::unshift_right(alloc_, elem_, sz_, idx, count, i);
+					throw;
+				}
+				sz_ += count;
+			}
+			else
+			{
+				pointer old_end = elem_ + sz_;
+				if (sz_ - idx > count)
+				{
+					move_to_end(old_end - count, old_end);
+					std::move_backward(elem_ + idx, old_end - count, old_end);
+					std::fill_n(elem_ + idx, count, tmp);
+				}
+				else
+				{
+					for (size_type k = sz_ - idx; k < count; ++k, ++sz_)
+						alloc_traits::construct(alloc_, elem_ + sz_, tmp);
+					move_to_end(elem_ + idx, old_end);
+					std::fill(elem_ + idx, old_end, tmp);
+				}
 			}
-			for (size_type i = 0; i < count; ++i)
-				alloc_traits::construct(alloc_, elem_ + idx + i, value);
-			sz_ += count;
 			return iterator(elem_ + idx);
 		}
 
@@ -365,19 +1542,54 @@ namespace miv
 		iterator insert(const_iterator pos, InputIt first, InputIt last)
 		{
 			size_type idx = pos - begin();
+			if constexpr (!detail::is_forward_iterator_v<InputIt>)
+			{
+				// однопроходный диапазон нельзя измерить заранее: собираем его отдельно
+				Vector tmp(first, last, alloc_);
+				return insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+			}
 			size_type count = std::distance(first, last);
-			if (sz_ + count > space_)
-				reserve(std::max(space_ * 2, sz_ + count));
-			for (size_type i = sz_; i > idx; --i)
+			if (count == 0)
+				return iterator(elem_ + idx);
+			if (sz_ + count > space_ &&
+				grow_insert(idx, count, ReallocReason::insert,
+							[&](pointer p) { detail::construct_range(alloc_, p, first, last); }))
+				return iterator(elem_ + idx);
+			if constexpr (nothrow_shift)
 			{
-				alloc_traits::construct(alloc_, elem_ + i + count - 1,
-										std::move_if_noexcept(elem_[i - 1]));
-				alloc_traits::destroy(alloc_, elem_ + i - 1);
+				detail::shift_right(alloc_, elem_, sz_, idx, count);
+				size_type i = 0;
+				try
+				{
+					for (; first != last; ++first, ++i)
+						alloc_traits::construct(alloc_, elem_ + idx + i, *first);
+				}
+				catch (...)
+				{
+					detail::unshift_right(alloc_, elem_, sz_, idx, count, i);
+					throw;
+				}
+				sz_ += count;
 			}
-			for (; first != last; ++first, ++idx)
-				alloc_traits::construct(alloc_, elem_ + idx, *first);
-			sz_ += count;
-			return iterator(elem_ + (pos - begin()));
+			else
+			{
+				pointer old_end = elem_ + sz_;
+				if (sz_ - idx > count)
+				{
+					move_to_end(old_end - count, old_end);
+					std::move_backward(elem_ + idx, old_end - count, old_end);
+					std::copy(first, last, elem_ + idx);
+				}
+				else
+				{
+					InputIt mid = std::next(first, static_cast<difference_type>(sz_ - idx));
+					for (InputIt it = mid; it != last; ++it, ++sz_)
+						alloc_traits::construct(alloc_, elem_ + sz_, *it);
+					move_to_end(elem_ + idx, old_end);
+					std::copy(first, mid, elem_ + idx);
+				}
+			}
+			return iterator(elem_ + idx);
 		}
 
 		iterator insert(const_iterator pos, std::initializer_list<T> il)
@@ -389,59 +1601,94 @@ namespace miv
 		iterator emplace(const_iterator pos, Args &&...args)
 		{
 			size_type idx = pos - begin();
-			if (space_ == 0)
-				reserve(8);
-			else if (sz_ == space_)
-				reserve(2 * space_);
-			for (size_type i = sz_; i > idx; --i)
-			{
-				alloc_traits::construct(alloc_, elem_ + i,
-										std::move_if_noexcept(elem_[i - 1]));
-				alloc_traits::destroy(alloc_, elem_ + i - 1);
-			}
-			alloc_traits::construct(alloc_, elem_ + idx, std::forward<Args>(args)...);
-			++sz_;
+			if (sz_ == space_)
+				grow_emplace(idx, ReallocReason::insert, std::forward<Args>(args)...);
+			else
+				emplace_here(idx, std::forward<Args>(args)...);
 			return iterator(elem_ + idx);
 		}
 
 		iterator erase(const_iterator pos)
 		{
-			size_type idx = pos - begin();
-			alloc_traits::destroy(alloc_, elem_ + idx);
-			for (size_type i = idx; i < sz_ - 1; ++i)
-			{
-				alloc_traits::construct(alloc_, elem_ + i,
-										std::move_if_noexcept(elem_[i + 1]));
-				alloc_traits::destroy(alloc_, elem_ + i + 1);
-			}
-			--sz_;
-			return iterator(elem_ + idx);
+			return erase(pos, pos + 1);
 		}
 
 		iterator erase(const_iterator first, const_iterator last)
 		{
 			size_type idx = first - begin();
 			size_type count = last - first;
-			for (size_type i = idx; i < idx + count; ++i)
-				alloc_traits::destroy(alloc_, elem_ + i);
-			for (size_type i = idx + count; i < sz_; ++i)
+			if (count == 0)
+				return iterator(elem_ + idx);
+			if constexpr (nothrow_shift)
 			{
-				alloc_traits::construct(alloc_, elem_ + i - count,
-										std::move_if_noexcept(elem_[i]));
-				alloc_traits::destroy(alloc_, elem_ + i);
+				for (size_type i = idx; i < idx + count; ++i)
+					alloc_traits::destroy(alloc_, elem_ + i);
+				detail::shift_left(alloc_, elem_, sz_, idx + count, count);
+			}
+			else
+			{
+				std::move(elem_ + idx + count, elem_ + sz_, elem_ + idx);
+				for (size_type i = sz_ - count; i < sz_; ++i)
+					alloc_traits::destroy(alloc_, elem_ + i);
 			}
 			sz_ -= count;
 			return iterator(elem_ + idx);
 		}
 
+		// Удаление всех элементов, для которых pred истинен, за один проход:
+		// оставшиеся сдвигаются move-присваиванием, уничтожается только хвост.
+		// Возвращает число удалённых элементов
+		template <typename Pred>
+		size_type remove_if(Pred pred)
+		{
+			size_type i = 0;
+			while (i < sz_ && !pred(std::as_const(elem_[i])))
+				++i;
+			size_type out = i;
+			for (++i; i < sz_; ++i)
+			{
+				if (!pred(std::as_const(elem_[i])))
+					elem_[out++] = std::move(elem_[i]);
+			}
+			size_type removed = sz_ - out;
+			for (size_type j = out; j < sz_; ++j)
+				alloc_traits::destroy(alloc_, elem_ + j);
+			sz_ = out;
+			return removed;
+		}
+
+		// Удаление за O(1) без сохранения порядка: на место pos встаёт
+		// последний элемент. Возвращает итератор на ту же позицию
+		iterator erase_unordered(const_iterator pos)
+		{
+			size_type idx = pos - begin();
+			if (idx + 1 != sz_)
+				elem_[idx] = std::move(elem_[sz_ - 1]);
+			alloc_traits::destroy(alloc_, elem_ + --sz_);
+			return iterator(elem_ + idx);
+		}
+
 		void swap(Vector &other) noexcept(
-			alloc_traits::propagate_on_container_swap::value)
+			alloc_traits::propagate_on_container_swap::value ||
+			alloc_traits::is_always_equal::value)
 		{
 			if constexpr (alloc_traits::propagate_on_container_swap::value)
+			{
 				std::swap(alloc_, other.alloc_);
-			std::swap(elem_, other.elem_);
-			std::swap(sz_, other.sz_);
-			std::swap(space_, other.space_);
+			}
+			else if constexpr (!alloc_traits::is_always_equal::value)
+			{
+				// разные аллокаторы без propagate: каждый вектор остаётся
+				// со своим аллокатором, содержимое обменивается переносом
+				if (alloc_ != other.alloc_)
+				{
+					Vector tmp(std::move(*this));
+					*this = std::move(other);
+					other = std::move(tmp);
+					return;
+				}
+			}
+			swap_storage(other);
 		}
 
 		constexpr reference operator[](size_type i) noexcept { return elem_[i]; }
@@ -480,88 +1727,495 @@ namespace miv
 		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
 		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
 
-		allocator_type get_allocator() const noexcept
+		allocator_type get_allocator() const noexcept
+		{
+			return alloc_;
+		}
+
+		size_type max_size() const noexcept
+		{
+			return alloc_traits::max_size(alloc_);
+		}
+
+		~Vector()
+		{
+			release_storage();
+		}
+
+	private:
+		allocator_type alloc_;
+		pointer elem_;
+		size_type sz_, space_;
+
+		// Сдвиг хвоста переносом не бросает исключений
+		static constexpr bool nothrow_shift = is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+		// Ёмкость для роста до need элементов по политике G
+		size_type next_capacity(size_type need) const noexcept
+		{
+			return G::grow(space_, need, sizeof(T));
+		}
+
+		pointer allocate_storage(size_type n)
+		{
+			pointer p = alloc_traits::allocate(alloc_, n);
+			if (p)
+				S::on_allocate(n * sizeof(T));
+			return p;
+		}
+
+		// used - сколько элементов было в блоке (для учёта slack)
+		void deallocate_storage(pointer p, size_type n, size_type used) noexcept
+		{
+			alloc_traits::deallocate(alloc_, p, n);
+			S::on_deallocate(n * sizeof(T), (n - used) * sizeof(T));
+		}
+
+		// Рост блока на месте или через mremap считается заменой блока
+		void note_expanded(size_type old_cap, bool moved, ReallocReason why) noexcept
+		{
+			S::on_deallocate(old_cap * sizeof(T), (old_cap - sz_) * sizeof(T));
+			S::on_allocate(space_ * sizeof(T));
+			S::on_reallocate(why, old_cap * sizeof(T), space_ * sizeof(T), moved ? sz_ : 0);
+		}
+
+		// Перенос в блок на new_cap > space_ элементов; при исключении
+		// вектор не меняется
+		void reallocate(size_type new_cap, ReallocReason why)
+		{
+			pointer old = elem_;
+			size_type old_cap = space_;
+			if (elem_ && detail::expand(alloc_, elem_, space_, new_cap))
+				return note_expanded(old_cap, elem_ != old, why);
+			pointer new_elem = allocate_storage(new_cap);
+			try
+			{
+				detail::relocate_around(alloc_, elem_, sz_, sz_, 0, new_elem);
+			}
+			catch (...)
+			{
+				deallocate_storage(new_elem, new_cap, 0);
+				throw;
+			}
+			if (elem_)
+			{
+				deallocate_storage(elem_, old_cap, sz_);
+				S::on_reallocate(why, old_cap * sizeof(T), new_cap * sizeof(T), sz_);
+			}
+			elem_ = new_elem;
+			space_ = new_cap;
+		}
+
+		// Рост для вставки count элементов в позицию idx. build(dst) строит
+		// их сразу в новом блоке, до переноса старых: аргументы могут
+		// ссылаться на элементы самого вектора, а исключение оставляет вектор
+		// нетронутым. false - блок вырос на месте, вставку делает вызывающий
+		template <typename Build>
+		bool grow_insert(size_type idx, size_type count, ReallocReason why, Build build)
+		{
+			size_type new_cap = next_capacity(sz_ + count);
+			size_type old_cap = space_;
+			if constexpr (detail::has_try_expand_v<A>)
+			{
+				if (elem_ && alloc_.try_expand(elem_, space_, new_cap))
+				{
+					space_ = new_cap;
+					note_expanded(old_cap, false, why);
+					return false;
+				}
+			}
+			pointer new_elem = allocate_storage(new_cap);
+			try
+			{
+				build(new_elem + idx);
+			}
+			catch (...)
+			{
+				deallocate_storage(new_elem, new_cap, 0);
+				throw;
+			}
+			try
+			{
+				detail::relocate_around(alloc_, elem_, sz_, idx, count, new_elem);
+			}
+			catch (...)
+			{
+				for (size_type i = 0; i < count; ++i)
+					alloc_traits::destroy(alloc_, new_elem + idx + i);
+				deallocate_storage(new_elem, new_cap, 0);
+				throw;
+			}
+			if (elem_)
+			{
+				deallocate_storage(elem_, old_cap, sz_);
+				S::on_reallocate(why, old_cap * sizeof(T), new_cap * sizeof(T), sz_);
+			}
+			elem_ = new_elem;
+			space_ = new_cap;
+			sz_ += count;
+			return true;
+		}
+
+		template <typename... Args>
+		void grow_emplace(size_type idx, ReallocReason why, Args &&...args)
 		{
-			return alloc_;
+			if constexpr (detail::has_reallocate_v<A> && is_trivially_relocatable_v<T>)
+			{
+				// reallocate (mremap) сдвигает блок целиком, новый элемент
+				// ждёт во временном буфере и переносится побайтово
+				if (elem_)
+				{
+					alignas(T) unsigned char buf[sizeof(T)];
+					T *tmp = reinterpret_cast<T *>(buf);
+					alloc_traits::construct(alloc_, tmp, std::forward<Args>(args)...);
+					try
+					{
+						reallocate(next_capacity(sz_ + 1), why);
+					}
+					catch (...)
+					{
+						alloc_traits::destroy(alloc_, tmp);
+						throw;
+					}
+					detail::shift_right(alloc_, elem_, sz_, idx, 1);
+					std::memcpy(static_cast<void *>(elem_ + idx), static_cast<const void *>(tmp), sizeof(T));
+					++sz_;
+					return;
+				}
+			}
+			if (!grow_insert(idx, 1, why,
+							 [&](pointer p) { alloc_traits::construct(alloc_, p, std::forward<Args>(args)...); }))
+				emplace_here(idx, std::forward<Args>(args)...);
 		}
 
-		size_type max_size() const noexcept
+		// Вставка одного элемента при свободной ёмкости
+		template <typename... Args>
+		void emplace_here(size_type idx, Args &&...args)
 		{
-			return alloc_traits::max_size(alloc_);
+			if (idx == sz_)
+			{
+				alloc_traits::construct(alloc_, elem_ + sz_, std::forward<Args>(args)...);
+				++sz_;
+			}
+			else if constexpr (is_trivially_relocatable_v<T>)
+			{
+				// элемент строится до сдвига: args могут ссылаться на хвост
+				alignas(T) unsigned char buf[sizeof(T)];
+				T *tmp = reinterpret_cast<T *>(buf);
+				alloc_traits::construct(alloc_, tmp, std::forward<Args>(args)...);
+				detail::shift_right(alloc_, elem_, sz_, idx, 1);
+				std::memcpy(static_cast<void *>(elem_ + idx), static_cast<const void *>(tmp), sizeof(T));
+				++sz_;
+			}
+			else if constexpr (nothrow_shift)
+			{
+				T tmp(std::forward<Args>(args)...);
+				detail::shift_right(alloc_, elem_, sz_, idx, 1);
+				alloc_traits::construct(alloc_, elem_ + idx, std::move(tmp));
+				++sz_;
+			}
+			else
+			{
+				T tmp(std::forward<Args>(args)...);
+				move_to_end(elem_ + sz_ - 1, elem_ + sz_);
+				std::move_backward(elem_ + idx, elem_ + sz_ - 2, elem_ + sz_ - 1);
+				elem_[idx] = std::move(tmp);
+			}
 		}
 
-		~Vector()
+		// Перемещение [from, to) в слоты за концом; sz_ растёт поэлементно,
+		// поэтому при исключении вектор остаётся согласованным
+		void move_to_end(pointer from, pointer to)
 		{
+			for (; from != to; ++from, ++sz_)
+				alloc_traits::construct(alloc_, elem_ + sz_, std::move(*from));
+		}
+
+		// Уничтожить элементы и вернуть буфер аллокатору
+		void release_storage() noexcept
+		{
+			size_type used = sz_;
 			clear();
 			if (elem_)
-				alloc_traits::deallocate(alloc_, elem_, space_);
+				deallocate_storage(elem_, space_, used);
+			elem_ = nullptr;
+			space_ = 0;
 		}
 
-	private:
-		allocator_type alloc_;
-		pointer elem_;
-		size_type sz_, space_;
+		void swap_storage(Vector &other) noexcept
+		{
+			std::swap(elem_, other.elem_);
+			std::swap(sz_, other.sz_);
+			std::swap(space_, other.space_);
+		}
 	};
 
-	// vector<bool>
-	template <typename A>
-	class Vector<bool, A>
+	namespace detail
+	{
+		inline unsigned popcount64(std::uint64_t w) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<unsigned>(__builtin_popcountll(w));
+#else
+			w = w - ((w >> 1) & 0x5555555555555555ull);
+			w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+			w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+			return static_cast<unsigned>((w * 0x0101010101010101ull) >> 56);
+#endif
+		}
+
+		// Номер младшего установленного бита; w != 0
+		inline unsigned ctz64(std::uint64_t w) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<unsigned>(__builtin_ctzll(w));
+#else
+			unsigned n = 0;
+			while (!(w & 1u))
+			{
+				w >>= 1;
+				++n;
+			}
+			return n;
+#endif
+		}
+	}
+
+	// vector<bool>: биты упакованы в 64-битные слова. Инвариант: биты последнего
+	// занятого слова за пределами size() всегда нулевые, поэтому count/any/==
+	// работают целыми словами без маскирования.
+	template <typename A, typename G, typename S>
+	class Vector<bool, A, G, S>
 	{
 	public:
 		using value_type = bool;
 		using size_type = std::size_t;
 		using allocator_type = A;
-		using byte_allocator =
-			typename std::allocator_traits<A>::template rebind_alloc<unsigned char>;
-		using alloc_traits = std::allocator_traits<byte_allocator>;
-		using reference = struct bit_reference;
-		using const_reference = bool;
+		using word_type = std::uint64_t;
+		using word_allocator =
+			typename std::allocator_traits<A>::template rebind_alloc<word_type>;
+		using alloc_traits = std::allocator_traits<word_allocator>;
+
+		static constexpr size_type word_bits = 64;
+		static constexpr size_type npos = static_cast<size_type>(-1);
 
-		// proxy для 1 бита
+		// proxy для 1 бита; запись помечает rank/select индекс владельца устаревшим
 		struct bit_reference
 		{
-			unsigned char *byte_;
-			unsigned char mask_;
-			bit_reference(unsigned char *b, unsigned char m) noexcept
-				: byte_(b), mask_(m) {}
+			Vector *owner_;
+			size_type pos_;
+			bit_reference(Vector *o, size_type pos) noexcept
+				: owner_(o), pos_(pos) {}
 			bit_reference &operator=(bool v) noexcept
 			{
 				if (v)
-					*byte_ |= mask_;
+					word() |= mask();
 				else
-					*byte_ &= ~mask_;
+					word() &= ~mask();
+				owner_->touch(pos_ / word_bits);
 				return *this;
 			}
+			bit_reference &operator=(const bit_reference &o) noexcept
+			{
+				return *this = bool(o);
+			}
 			operator bool() const noexcept
 			{
-				return (*byte_ & mask_) != 0;
+				return (word() & mask()) != 0;
+			}
+			void flip() noexcept
+			{
+				word() ^= mask();
+				owner_->touch(pos_ / word_bits);
 			}
+
+		private:
+			word_type &word() const noexcept { return owner_->data_[pos_ / word_bits]; }
+			word_type mask() const noexcept { return word_type(1) << (pos_ % word_bits); }
 		};
 
+		using reference = bit_reference;
+		using const_reference = bool;
+
 	private:
-		byte_allocator alloc_;
-		unsigned char *data_;
-		size_type sz_, space_;
+		// Succinct rank/select индекс: абсолютные счётчики на суперблок
+		// (64 слова), 16-битные относительные на блок (8 слов) и выборка
+		// суперблоков для каждой 4096-й единицы. Накладные расходы < 1%.
+		// Пересчитывается лениво, начиная с первого изменённого слова.
+		struct RankIndex
+		{
+			static constexpr size_type words_per_block = 8;
+			static constexpr size_type words_per_super = 64;
+			static constexpr size_type blocks_per_super = words_per_super / words_per_block;
+			static constexpr size_type sample_rate = 4096;
+
+			Vector<std::uint64_t> super_;	// единиц до суперблока
+			Vector<std::uint16_t> block_;	// единиц до блока внутри суперблока
+			Vector<std::uint64_t> samples_; // суперблок с (j * sample_rate)-й единицей
+			size_type ones_ = 0;
+			size_type dirty_ = 0; // первое изменённое слово, npos - индекс актуален
+
+			void refresh(const word_type *data, size_type nwords)
+			{
+				if (dirty_ == npos)
+					return;
+				size_type nsuper = nwords / words_per_super + 1;
+				size_type nblocks = nwords / words_per_block + 1;
+				size_type s0 = std::min(dirty_ / words_per_super, nsuper - 1);
+				s0 = super_.empty() ? 0 : std::min(s0, super_.size() - 1);
+				super_.resize(nsuper);
+				block_.resize(nblocks);
+
+				size_type cum = s0 ? super_[s0] : 0;
+				size_type keep = (cum + sample_rate - 1) / sample_rate;
+				samples_.resize(std::min(keep, samples_.size()));
+				for (size_type s = s0; s < nsuper; ++s)
+				{
+					super_[s] = cum;
+					size_type base = cum;
+					size_type bend = std::min((s + 1) * blocks_per_super, nblocks);
+					for (size_type b = s * blocks_per_super; b < bend; ++b)
+					{
+						block_[b] = static_cast<std::uint16_t>(cum - base);
+						size_type wend = std::min((b + 1) * words_per_block, nwords);
+						for (size_type w = b * words_per_block; w < wend; ++w)
+							cum += detail::popcount64(data[w]);
+					}
+				}
+				ones_ = cum;
+
+				size_type next = samples_.size() * sample_rate;
+				for (size_type s = s0; s < nsuper; ++s)
+				{
+					size_type end = s + 1 < nsuper ? super_[s + 1] : ones_;
+					for (; next < end; next += sample_rate)
+						samples_.push_back(s);
+				}
+				dirty_ = npos;
+			}
+		};
+
+		word_allocator alloc_;
+		word_type *data_;
+		size_type sz_, words_; // размер в битах, ёмкость в словах
+		std::unique_ptr<RankIndex> index_;
+
+		// слово w изменилось: счётчики индекса после него устарели
+		void touch(size_type w) noexcept
+		{
+			if (index_ && w < index_->dirty_)
+				index_->dirty_ = w;
+		}
+
+		// позиция r-го (с нуля) установленного бита в слове
+		static size_type select_in_word(word_type w, size_type r) noexcept
+		{
+			size_type shift = 0;
+			for (;; shift += 8)
+			{
+				size_type c = detail::popcount64((w >> shift) & 0xFFu);
+				if (r < c)
+					break;
+				r -= c;
+			}
+			word_type byte = (w >> shift) & 0xFFu;
+			for (; r; --r)
+				byte &= byte - 1;
+			return shift + detail::ctz64(byte);
+		}
+
+		static constexpr size_type words_for(size_type bits) noexcept
+		{
+			return (bits + word_bits - 1) / word_bits;
+		}
+
+		// маска битов [0, n) слова; n в [1, 64]
+		static constexpr word_type low_mask(size_type n) noexcept
+		{
+			return n >= word_bits ? ~word_type(0) : (word_type(1) << n) - 1;
+		}
+
+		// обнулить хвост последнего слова за пределами sz_
+		void trim() noexcept
+		{
+			if (size_type r = sz_ % word_bits)
+				data_[sz_ / word_bits] &= low_mask(r);
+		}
+
+		// применить op(word, mask) ко всем словам диапазона [first, last)
+		template <typename Op>
+		void for_range(size_type first, size_type last, Op op) noexcept
+		{
+			if (first >= last)
+				return;
+			size_type fw = first / word_bits, lw = (last - 1) / word_bits;
+			word_type head = ~word_type(0) << (first % word_bits);
+			word_type tail = low_mask(last - lw * word_bits);
+			if (fw == lw)
+				return op(data_[fw], head & tail);
+			op(data_[fw], head);
+			for (size_type w = fw + 1; w < lw; ++w)
+				op(data_[w], ~word_type(0));
+			op(data_[lw], tail);
+		}
+
+		// Перенос в блок на new_words > words_ слов
+		void reallocate(size_type new_words, ReallocReason why)
+		{
+			word_type *old = data_;
+			size_type old_words = words_, used = words_for(sz_);
+			constexpr size_type ws = sizeof(word_type);
+			if (data_ && detail::expand(alloc_, data_, words_, new_words))
+			{
+				S::on_deallocate(old_words * ws, (old_words - used) * ws);
+				S::on_allocate(new_words * ws);
+				S::on_reallocate(why, old_words * ws, new_words * ws, data_ == old ? 0 : used);
+				return;
+			}
+			word_type *new_data = alloc_traits::allocate(alloc_, new_words);
+			S::on_allocate(new_words * ws);
+			if (data_)
+			{
+				std::copy(data_, data_ + used, new_data);
+				alloc_traits::deallocate(alloc_, data_, words_);
+				S::on_deallocate(old_words * ws, (old_words - used) * ws);
+				S::on_reallocate(why, old_words * ws, new_words * ws, used);
+			}
+			data_ = new_data;
+			words_ = new_words;
+		}
 
-		static size_type bytes_for_bits(size_type b) noexcept
+		void release_storage() noexcept
 		{
-			return (b + 7) / 8;
+			if (data_)
+			{
+				alloc_traits::deallocate(alloc_, data_, words_);
+				S::on_deallocate(words_ * sizeof(word_type), (words_ - words_for(sz_)) * sizeof(word_type));
+			}
+			data_ = nullptr;
+			sz_ = words_ = 0;
+			touch(0);
+		}
+
+		void swap_storage(Vector &other) noexcept
+		{
+			std::swap(data_, other.data_);
+			std::swap(sz_, other.sz_);
+			std::swap(words_, other.words_);
+			std::swap(index_, other.index_);
 		}
 
 	public:
-		Vector() noexcept
-			: alloc_(byte_allocator()), data_(nullptr), sz_(0), space_(0)
+		Vector(const allocator_type &alloc = allocator_type()) noexcept
+			: alloc_(alloc), data_(nullptr), sz_(0), words_(0)
 		{
 		}
 
 		explicit Vector(size_type n, bool v = false,
-						const allocator_type & = allocator_type())
-			: alloc_(byte_allocator()), sz_(n), space_(n)
+						const allocator_type &alloc = allocator_type())
+			: Vector(alloc)
 		{
-			size_type bytes = bytes_for_bits(n);
-			data_ = alloc_traits::allocate(alloc_, bytes);
-			unsigned char fill = v ? 0xFFu : 0x00u;
-			std::fill_n(data_, bytes, fill);
+			resize(n, v);
 		}
 
 		Vector(std::initializer_list<bool> il,
@@ -574,104 +2228,139 @@ namespace miv
 		}
 
 		Vector(const Vector &other)
-			: alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_)), sz_(other.sz_), space_(other.space_)
+			: alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_)), data_(nullptr), sz_(0), words_(0)
 		{
-			size_type bytes = bytes_for_bits(space_);
-			data_ = alloc_traits::allocate(alloc_, bytes);
-			std::copy(other.data_, other.data_ + bytes, data_);
+			reserve(other.sz_);
+			std::copy(other.data_, other.data_ + words_for(other.sz_), data_);
+			sz_ = other.sz_;
 		}
 
 		Vector(Vector &&other) noexcept
-			: alloc_(std::move(other.alloc_)), data_(other.data_), sz_(other.sz_), space_(other.space_)
+			: alloc_(std::move(other.alloc_)), data_(other.data_), sz_(other.sz_), words_(other.words_),
+			  index_(std::move(other.index_))
 		{
 			other.data_ = nullptr;
-			other.sz_ = other.space_ = 0;
+			other.sz_ = other.words_ = 0;
 		}
 
 		Vector &operator=(const Vector &other)
 		{
 			if (this == &other)
 				return *this;
-			Vector tmp(other);
-			swap(tmp);
+			if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+			{
+				if (alloc_ != other.alloc_)
+				{
+					release_storage();
+					alloc_ = other.alloc_;
+				}
+			}
+			reserve(other.sz_);
+			std::copy(other.data_, other.data_ + words_for(other.sz_), data_);
+			sz_ = other.sz_;
+			touch(0);
 			return *this;
 		}
 
-		Vector &operator=(Vector &&other) noexcept
+		Vector &operator=(Vector &&other) noexcept(
+			alloc_traits::propagate_on_container_move_assignment::value ||
+			alloc_traits::is_always_equal::value)
 		{
-			if (this != &other)
+			if (this == &other)
+				return *this;
+			if constexpr (!alloc_traits::propagate_on_container_move_assignment::value)
 			{
-				if (data_)
-					alloc_traits::deallocate(alloc_, data_, bytes_for_bits(space_));
-				alloc_ = std::move(other.alloc_);
-				data_ = other.data_;
-				sz_ = other.sz_;
-				space_ = other.space_;
-				other.data_ = nullptr;
-				other.sz_ = other.space_ = 0;
+				if (alloc_ != other.alloc_)
+				{
+					*this = static_cast<const Vector &>(other);
+					other.clear();
+					return *this;
+				}
 			}
+			release_storage();
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+				alloc_ = std::move(other.alloc_);
+			swap_storage(other);
 			return *this;
 		}
 
-		void swap(Vector &other) noexcept
+		void swap(Vector &other) noexcept(
+			alloc_traits::propagate_on_container_swap::value ||
+			alloc_traits::is_always_equal::value)
 		{
-			std::swap(alloc_, other.alloc_);
-			std::swap(data_, other.data_);
-			std::swap(sz_, other.sz_);
-			std::swap(space_, other.space_);
+			if constexpr (alloc_traits::propagate_on_container_swap::value)
+			{
+				std::swap(alloc_, other.alloc_);
+			}
+			else if constexpr (!alloc_traits::is_always_equal::value)
+			{
+				if (alloc_ != other.alloc_)
+				{
+					Vector tmp(std::move(*this));
+					*this = std::move(other);
+					other = std::move(tmp);
+					return;
+				}
+			}
+			swap_storage(other);
 		}
 
 		bool empty() const noexcept { return sz_ == 0; }
 		size_type size() const noexcept { return sz_; }
-		size_type capacity() const noexcept { return space_; }
+		size_type capacity() const noexcept { return words_ * word_bits; }
+		size_type num_words() const noexcept { return words_for(sz_); }
 
 		void reserve(size_type new_cap)
 		{
-			if (new_cap <= space_)
-				return;
-			size_type new_bytes = bytes_for_bits(new_cap);
-			unsigned char *new_data = alloc_traits::allocate(alloc_, new_bytes);
-			size_type old_bytes = bytes_for_bits(sz_);
-			std::copy(data_, data_ + old_bytes, new_data);
-			if (data_)
-				alloc_traits::deallocate(alloc_, data_, bytes_for_bits(space_));
-			data_ = new_data;
-			space_ = new_cap;
+			size_type new_words = words_for(new_cap);
+			if (new_words > words_)
+				reallocate(new_words, ReallocReason::reserve);
 		}
 
 		void resize(size_type new_size, bool v = false)
 		{
-			if (new_size > space_)
+			touch(std::min(sz_, new_size) / word_bits);
+			if (new_size > sz_)
+			{
 				reserve(new_size);
-			for (size_type i = sz_; i < new_size; ++i)
-				(*this)[i] = v;
+				size_type used = words_for(sz_), need = words_for(new_size);
+				std::fill(data_ + used, data_ + need, word_type(0));
+				if (v)
+					for_range(sz_, new_size, [](word_type &w, word_type m) { w |= m; });
+			}
 			sz_ = new_size;
+			trim();
 		}
 
 		void push_back(bool v)
 		{
-			if (space_ == 0)
-				reserve(8);
-			else if (sz_ == space_)
-				reserve(2 * space_);
-			(*this)[sz_++] = v;
+			if (sz_ == capacity())
+				reallocate(G::grow(words_, words_for(sz_ + 1), sizeof(word_type)), ReallocReason::push_back);
+			word_type &w = data_[sz_ / word_bits];
+			if (sz_ % word_bits == 0)
+				w = 0;
+			w |= word_type(v) << (sz_ % word_bits);
+			touch(sz_ / word_bits);
+			++sz_;
 		}
-		void pop_back()
+		void pop_back() noexcept
 		{
 			if (sz_ > 0)
+			{
 				--sz_;
+				trim();
+				touch(sz_ / word_bits);
+			}
 		}
 
 		// element access
 		reference operator[](size_type i) noexcept
 		{
-			unsigned char *byte = data_ + (i / 8);
-			unsigned char mask = static_cast<unsigned char>(1u << (i % 8));
-			return bit_reference(byte, mask);
+			return bit_reference(this, i);
 		}
 		const_reference operator[](size_type i) const noexcept
 		{
-			return (data_[i / 8] >> (i % 8)) & 1u;
+			return (data_[i / word_bits] >> (i % word_bits)) & 1u;
 		}
 
 		reference at(size_type i)
@@ -687,56 +2376,360 @@ namespace miv
 			return (*this)[i];
 		}
 
-		void clear() noexcept { sz_ = 0; }
+		void clear() noexcept
+		{
+			sz_ = 0;
+			touch(0);
+		}
+
+		// Пословные операции
+		size_type count() const noexcept
+		{
+			size_type n = 0;
+			for (size_type w = 0, e = words_for(sz_); w < e; ++w)
+				n += detail::popcount64(data_[w]);
+			return n;
+		}
+
+		bool any() const noexcept
+		{
+			for (size_type w = 0, e = words_for(sz_); w < e; ++w)
+				if (data_[w])
+					return true;
+			return false;
+		}
+		bool none() const noexcept { return !any(); }
+		bool all() const noexcept
+		{
+			size_type full = sz_ / word_bits;
+			for (size_type w = 0; w < full; ++w)
+				if (data_[w] != ~word_type(0))
+					return false;
+			size_type r = sz_ % word_bits;
+			return r == 0 || data_[full] == low_mask(r);
+		}
+
+		// Позиция первого установленного бита, npos если таких нет
+		size_type find_first() const noexcept
+		{
+			for (size_type w = 0, e = words_for(sz_); w < e; ++w)
+				if (data_[w])
+					return w * word_bits + detail::ctz64(data_[w]);
+			return npos;
+		}
+
+		// Позиция первого установленного бита после pos, npos если таких нет
+		size_type find_next(size_type pos) const noexcept
+		{
+			if (++pos >= sz_)
+				return npos;
+			size_type w = pos / word_bits;
+			word_type cur = data_[w] & (~word_type(0) << (pos % word_bits));
+			for (size_type e = words_for(sz_);;)
+			{
+				if (cur)
+					return w * word_bits + detail::ctz64(cur);
+				if (++w == e)
+					return npos;
+				cur = data_[w];
+			}
+		}
+
+		Vector &set() noexcept
+		{
+			std::fill(data_, data_ + words_for(sz_), ~word_type(0));
+			trim();
+			touch(0);
+			return *this;
+		}
+		Vector &set(size_type pos, bool v = true) noexcept
+		{
+			(*this)[pos] = v;
+			return *this;
+		}
+		Vector &set_range(size_type first, size_type last, bool v = true) noexcept
+		{
+			touch(first / word_bits);
+			if (v)
+				for_range(first, last, [](word_type &w, word_type m) { w |= m; });
+			else
+				for_range(first, last, [](word_type &w, word_type m) { w &= ~m; });
+			return *this;
+		}
+
+		Vector &reset() noexcept
+		{
+			std::fill(data_, data_ + words_for(sz_), word_type(0));
+			touch(0);
+			return *this;
+		}
+		Vector &reset(size_type pos) noexcept { return set(pos, false); }
+		Vector &reset_range(size_type first, size_type last) noexcept { return set_range(first, last, false); }
+
+		Vector &flip() noexcept
+		{
+			for (size_type w = 0, e = words_for(sz_); w < e; ++w)
+				data_[w] = ~data_[w];
+			trim();
+			touch(0);
+			return *this;
+		}
+		Vector &flip(size_type pos) noexcept
+		{
+			(*this)[pos].flip();
+			return *this;
+		}
+		Vector &flip_range(size_type first, size_type last) noexcept
+		{
+			touch(first / word_bits);
+			for_range(first, last, [](word_type &w, word_type m) { w ^= m; });
+			return *this;
+		}
+
+		// Побитовые операции между масками; биты за пределами other.size()
+		// считаются нулевыми
+		Vector &operator&=(const Vector &other) noexcept
+		{
+			size_type e = words_for(sz_), common = std::min(e, words_for(other.sz_));
+			for (size_type w = 0; w < common; ++w)
+				data_[w] &= other.data_[w];
+			std::fill(data_ + common, data_ + e, word_type(0));
+			touch(0);
+			return *this;
+		}
+		Vector &operator|=(const Vector &other) noexcept
+		{
+			size_type common = std::min(words_for(sz_), words_for(other.sz_));
+			for (size_type w = 0; w < common; ++w)
+				data_[w] |= other.data_[w];
+			trim();
+			touch(0);
+			return *this;
+		}
+		Vector &operator^=(const Vector &other) noexcept
+		{
+			size_type common = std::min(words_for(sz_), words_for(other.sz_));
+			for (size_type w = 0; w < common; ++w)
+				data_[w] ^= other.data_[w];
+			trim();
+			touch(0);
+			return *this;
+		}
+		Vector operator~() const
+		{
+			Vector r(*this);
+			r.flip();
+			return r;
+		}
+
+		// Rank / select. Без build_index() считаются линейным проходом по словам;
+		// с индексом rank - O(1), select - почти O(1). Изменения битовой маски
+		// помечают индекс устаревшим, пересчёт идёт лениво при следующем запросе
+		// и только с первого изменённого слова. Первый запрос после изменения
+		// не потокобезопасен: перед параллельным чтением вызовите build_index().
+		void build_index()
+		{
+			if (!index_)
+				index_ = std::make_unique<RankIndex>();
+			index_->dirty_ = 0;
+			index_->refresh(data_, words_for(sz_));
+		}
+		void drop_index() noexcept { index_.reset(); }
+		bool has_index() const noexcept { return index_ != nullptr; }
+
+		// Число установленных битов в [0, i), i <= size()
+		size_type rank(size_type i) const
+		{
+			size_type w = i / word_bits, r = 0, x = 0;
+			if (index_)
+			{
+				index_->refresh(data_, words_for(sz_));
+				size_type b = w / RankIndex::words_per_block;
+				r = index_->super_[w / RankIndex::words_per_super] + index_->block_[b];
+				x = b * RankIndex::words_per_block;
+			}
+			for (; x < w; ++x)
+				r += detail::popcount64(data_[x]);
+			if (i % word_bits)
+				r += detail::popcount64(data_[w] & low_mask(i % word_bits));
+			return r;
+		}
+
+		// Позиция k-го (с нуля) установленного бита, npos если единиц меньше k + 1
+		size_type select(size_type k) const
+		{
+			size_type nwords = words_for(sz_), w = 0;
+			if (index_)
+			{
+				RankIndex &ix = *index_;
+				ix.refresh(data_, nwords);
+				if (k >= ix.ones_)
+					return npos;
+				size_type s = ix.samples_[k / RankIndex::sample_rate];
+				while (s + 1 < ix.super_.size() && ix.super_[s + 1] <= k)
+					++s;
+				k -= ix.super_[s];
+				size_type b = s * RankIndex::blocks_per_super;
+				size_type bend = std::min(b + RankIndex::blocks_per_super, ix.block_.size());
+				while (b + 1 < bend && ix.block_[b + 1] <= k)
+					++b;
+				k -= ix.block_[b];
+				w = b * RankIndex::words_per_block;
+			}
+			for (; w < nwords; ++w)
+			{
+				size_type c = detail::popcount64(data_[w]);
+				if (k < c)
+					return w * word_bits + select_in_word(data_[w], k);
+				k -= c;
+			}
+			return npos;
+		}
+
+		// После записи напрямую в data() индекс нужно перестроить через build_index()
+		word_type *data() noexcept { return data_; }
+		const word_type *data() const noexcept { return data_; }
 
-		unsigned char *data() noexcept { return data_; }
-		const unsigned char *data() const noexcept { return data_; }
+		allocator_type get_allocator() const noexcept
+		{
+			return allocator_type(alloc_);
+		}
 
 		~Vector()
 		{
-			if (data_)
-				alloc_traits::deallocate(alloc_, data_, bytes_for_bits(space_));
+			release_storage();
 		}
 	};
 
+	template <typename A, typename G, typename S>
+	bool operator==(const Vector<bool, A, G, S> &x, const Vector<bool, A, G, S> &y)
+	{
+		return x.size() == y.size() &&
+			   std::equal(x.data(), x.data() + x.num_words(), y.data());
+	}
+	template <typename A, typename G, typename S>
+	bool operator!=(const Vector<bool, A, G, S> &x, const Vector<bool, A, G, S> &y)
+	{
+		return !(x == y);
+	}
+
+	// Лексикографически по битам, пословно: первый различающийся бит -
+	// младший установленный бит x ^ y в общей части
+	template <typename A, typename G, typename S>
+	bool operator<(const Vector<bool, A, G, S> &x, const Vector<bool, A, G, S> &y)
+	{
+		using word_type = typename Vector<bool, A, G, S>::word_type;
+		constexpr std::size_t bits = Vector<bool, A, G, S>::word_bits;
+		std::size_t n = std::min(x.size(), y.size());
+		for (std::size_t w = 0; w * bits < n; ++w)
+		{
+			word_type d = x.data()[w] ^ y.data()[w];
+			if (n - w * bits < bits)
+				d &= (word_type(1) << (n - w * bits)) - 1;
+			if (d)
+				return (y.data()[w] >> detail::ctz64(d)) & 1;
+		}
+		return x.size() < y.size();
+	}
+	template <typename A, typename G, typename S>
+	bool operator>(const Vector<bool, A, G, S> &x, const Vector<bool, A, G, S> &y)
+	{
+		return y < x;
+	}
+	template <typename A, typename G, typename S>
+	bool operator<=(const Vector<bool, A, G, S> &x, const Vector<bool, A, G, S> &y)
+	{
+		return !(y < x);
+	}
+	template <typename A, typename G, typename S>
+	bool operator>=(const Vector<bool, A, G, S> &x, const Vector<bool, A, G, S> &y)
+	{
+		return !(x < y);
+	}
+
+	template <typename A, typename G, typename S>
+	Vector<bool, A, G, S> operator&(Vector<bool, A, G, S> x, const Vector<bool, A, G, S> &y)
+	{
+		x &= y;
+		return x;
+	}
+	template <typename A, typename G, typename S>
+	Vector<bool, A, G, S> operator|(Vector<bool, A, G, S> x, const Vector<bool, A, G, S> &y)
+	{
+		x |= y;
+		return x;
+	}
+	template <typename A, typename G, typename S>
+	Vector<bool, A, G, S> operator^(Vector<bool, A, G, S> x, const Vector<bool, A, G, S> &y)
+	{
+		x ^= y;
+		return x;
+	}
+
+	// Как std::erase_if / std::erase (C++20): один проход, число удалённых
+	template <typename T, typename A, typename G, typename S, typename Pred>
+	typename Vector<T, A, G, S>::size_type erase_if(Vector<T, A, G, S> &v, Pred pred)
+	{
+		return v.remove_if(std::move(pred));
+	}
+	template <typename T, typename A, typename G, typename S, typename U>
+	typename Vector<T, A, G, S>::size_type erase(Vector<T, A, G, S> &v, const U &value)
+	{
+		return v.remove_if([&value](const T &x) { return x == value; });
+	}
+
 	// ADL (free swap) [add 02.06.2025]
-	template <typename T, typename A>
-	void swap(Vector<T, A> &x, Vector<T, A> &y) noexcept(noexcept(x.swap(y)))
+	template <typename T, typename A, typename G, typename S>
+	void swap(Vector<T, A, G, S> &x, Vector<T, A, G, S> &y) noexcept(noexcept(x.swap(y)))
 	{
 		x.swap(y);
 	}
 
 	// (spaceship mb добавить в будущем?)
-	template <typename T, typename A>
-	bool operator==(const Vector<T, A> &x, const Vector<T, A> &y)
+	template <typename T, typename A, typename G, typename S>
+	bool operator==(const Vector<T, A, G, S> &x, const Vector<T, A, G, S> &y)
 	{
 		if (x.size() != y.size())
 			return false;
-		return std::equal(x.begin(), x.end(), y.begin());
+		if constexpr (is_bitwise_comparable_v<T>)
+		{
+			static_assert(std::has_unique_object_representations_v<T>,
+						  "is_bitwise_comparable requires a type without padding");
+			return x.empty() || std::memcmp(x.data(), y.data(), x.size() * sizeof(T)) == 0;
+		}
+		else
+			return std::equal(x.data(), x.data() + x.size(), y.data());
 	}
-	template <typename T, typename A>
-	bool operator!=(const Vector<T, A> &x, const Vector<T, A> &y)
+	template <typename T, typename A, typename G, typename S>
+	bool operator!=(const Vector<T, A, G, S> &x, const Vector<T, A, G, S> &y)
 	{
 		return !(x == y);
 	}
-	template <typename T, typename A>
-	bool operator<(const Vector<T, A> &x, const Vector<T, A> &y)
+	template <typename T, typename A, typename G, typename S>
+	bool operator<(const Vector<T, A, G, S> &x, const Vector<T, A, G, S> &y)
 	{
-		return std::lexicographical_compare(x.begin(), x.end(),
-											y.begin(), y.end());
+		if constexpr (detail::bytewise_less_v<T>)
+		{
+			std::size_t n = std::min(x.size(), y.size());
+			int r = n ? std::memcmp(x.data(), y.data(), n) : 0;
+			return r < 0 || (r == 0 && x.size() < y.size());
+		}
+		else
+			return std::lexicographical_compare(x.data(), x.data() + x.size(),
+												y.data(), y.data() + y.size());
 	}
-	template <typename T, typename A>
-	bool operator>(const Vector<T, A> &x, const Vector<T, A> &y)
+	template <typename T, typename A, typename G, typename S>
+	bool operator>(const Vector<T, A, G, S> &x, const Vector<T, A, G, S> &y)
 	{
 		return y < x;
 	}
-	template <typename T, typename A>
-	bool operator<=(const Vector<T, A> &x, const Vector<T, A> &y)
+	template <typename T, typename A, typename G, typename S>
+	bool operator<=(const Vector<T, A, G, S> &x, const Vector<T, A, G, S> &y)
 	{
 		return !(y < x);
 	}
-	template <typename T, typename A>
-	bool operator>=(const Vector<T, A> &x, const Vector<T, A> &y)
+	template <typename T, typename A, typename G, typename S>
+	bool operator>=(const Vector<T, A, G, S> &x, const Vector<T, A, G, S> &y)
 	{
 		return !(x < y);
 	}
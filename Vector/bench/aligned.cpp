@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include "../Allocators.h"
+
+using namespace miv;
+
+/*
+ * Большие векторы float: Allocator против AlignedAllocator<64> и
+ * HugePageAllocator (madvise(MADV_HUGEPAGE)). Заполнение (page faults),
+ * последовательное сканирование и случайный доступ (промахи TLB).
+ */
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure_ms(F &&f)
+{
+	auto t0 = Clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+template <typename A>
+void run(const char *name, std::size_t n)
+{
+	double fill = 0, scan = 0, gather = 0;
+	float sink = 0;
+	{
+		Vector<float, A> v;
+		fill = measure_ms([&] { v.resize(n, 1.0f); });
+		std::printf("%-20s data %% 64 = %2zu  ", name, std::size_t(reinterpret_cast<std::uintptr_t>(v.data()) % 64));
+		scan = measure_ms([&] {
+			for (int rep = 0; rep < 10; ++rep)
+			{
+				float s = 0;
+				const float *p = v.data();
+				for (std::size_t i = 0; i < n; ++i)
+					s += p[i];
+				sink += s;
+			}
+		});
+		gather = measure_ms([&] {
+			std::uint64_t x = 88172645463325252ull;
+			const float *p = v.data();
+			float s = 0;
+			for (std::size_t i = 0; i < 20000000; ++i)
+			{
+				x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+				s += p[x % n];
+			}
+			sink += s;
+		});
+	}
+	std::printf("fill %8.2f ms  scan x10 %8.2f ms  random 20M %8.2f ms (%g)\n", fill, scan, gather, sink);
+}
+
+auto main() -> int
+{
+	const std::size_t n = std::size_t(64) << 20; // 256 MiB float
+	run<Allocator<float>>("Allocator", n);
+	run<AlignedAllocator<float, 64>>("AlignedAllocator<64>", n);
+	run<HugePageAllocator<float>>("HugePageAllocator", n);
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include <chrono>
+#include <cstdio>
+#include "../Allocators.h"
+
+using namespace miv;
+
+/*
+ * Запросно-ориентированная нагрузка: на каждый "запрос" строится набор
+ * коротких векторов, затем всё выбрасывается. Allocator (operator new/delete)
+ * против ArenaAllocator (reset на запрос) и PoolAllocator.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int requests = 20000;
+constexpr int vectors_per_request = 64;
+
+template <typename MakeAlloc, typename EndRequest>
+double run(MakeAlloc make_alloc, EndRequest end_request)
+{
+	long long checksum = 0;
+	auto t0 = Clock::now();
+	for (int r = 0; r < requests; ++r)
+	{
+		{
+			auto alloc = make_alloc();
+			using A = decltype(alloc);
+			Vector<Vector<int, A>, typename std::allocator_traits<A>::template rebind_alloc<Vector<int, A>>> all(alloc);
+			for (int v = 0; v < vectors_per_request; ++v)
+			{
+				Vector<int, A> vec(alloc);
+				for (int i = 0; i < (v * 7 + r) % 50; ++i)
+					vec.push_back(i);
+				checksum += vec.size();
+				all.push_back(std::move(vec));
+			}
+		}
+		end_request();
+	}
+	std::printf("  (checksum %lld)\n", checksum);
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+auto main() -> int
+{
+	double heap = run([] { return Allocator<int>(); }, [] {});
+	Arena arena;
+	double arena_ms = run([&] { return ArenaAllocator<int>(arena); }, [&] { arena.reset(); });
+	Pool pool;
+	double pool_ms = run([&] { return PoolAllocator<int>(pool); }, [] {});
+
+	std::printf("%-16s %10.2f ms\n", "Allocator", heap);
+	std::printf("%-16s %10.2f ms\n", "ArenaAllocator", arena_ms);
+	std::printf("%-16s %10.2f ms\n", "PoolAllocator", pool_ms);
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * Пословные операции Vector<bool> против побитового доступа через
+ * operator[] и против std::vector<bool> на масках в 64M строк.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure_ms(F &&f)
+{
+	auto t0 = Clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+auto main() -> int
+{
+	const std::size_t n = std::size_t(64) << 20;
+	Vector<bool> a(n), b(n);
+	std::vector<bool> sa(n), sb(n);
+	std::uint64_t x = 0x9E3779B97F4A7C15ull;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+		bool va = (x & 7) == 0, vb = (x & 24) != 0;
+		a[i] = va, b[i] = vb;
+		sa[i] = va, sb[i] = vb;
+	}
+
+	std::size_t r1 = 0, r2 = 0, r3 = 0;
+	std::printf("%-22s %12s %12s %16s\n", "operation", "words", "per-bit", "std::vector<bool>");
+
+	double w = measure_ms([&] { r1 = a.count(); });
+	double p = measure_ms([&] { for (std::size_t i = 0; i < n; ++i) r2 += a[i]; });
+	double s = measure_ms([&] { for (std::size_t i = 0; i < n; ++i) r3 += sa[i]; });
+	std::printf("%-22s %9.2f ms %9.2f ms %13.2f ms (%zu %zu %zu)\n", "count", w, p, s, r1, r2, r3);
+
+	r1 = r2 = r3 = 0;
+	w = measure_ms([&] { for (auto i = a.find_first(); i != a.npos; i = a.find_next(i)) r1 += i; });
+	p = measure_ms([&] { for (std::size_t i = 0; i < n; ++i) if (a[i]) r2 += i; });
+	s = measure_ms([&] { for (std::size_t i = 0; i < n; ++i) if (sa[i]) r3 += i; });
+	std::printf("%-22s %9.2f ms %9.2f ms %13.2f ms (%zu %zu %zu)\n", "iterate set bits", w, p, s, r1, r2, r3);
+
+	Vector<bool> c(a);
+	std::vector<bool> sc(sa);
+	w = measure_ms([&] { c &= b; });
+	p = measure_ms([&] { for (std::size_t i = 0; i < n; ++i) a[i] = a[i] && b[i]; });
+	s = measure_ms([&] { for (std::size_t i = 0; i < n; ++i) sc[i] = sc[i] && sb[i]; });
+	std::printf("%-22s %9.2f ms %9.2f ms %13.2f ms\n", "&= mask", w, p, s);
+
+	w = measure_ms([&] { c.set_range(n / 4, 3 * n / 4); });
+	p = measure_ms([&] { for (std::size_t i = n / 4; i < 3 * n / 4; ++i) a[i] = true; });
+	s = measure_ms([&] { std::fill(sc.begin() + n / 4, sc.begin() + 3 * n / 4, true); });
+	std::printf("%-22s %9.2f ms %9.2f ms %13.2f ms\n", "range set", w, p, s);
+
+	w = measure_ms([&] { Vector<bool> t(0); for (std::size_t i = 0; i < n; ++i) t.push_back(i & 1); r1 = t.size(); });
+	s = measure_ms([&] { std::vector<bool> t; for (std::size_t i = 0; i < n; ++i) t.push_back(i & 1); r3 = t.size(); });
+	std::printf("%-22s %9.2f ms %12s %13.2f ms\n", "push_back", w, "-", s);
+	return 0;
+}
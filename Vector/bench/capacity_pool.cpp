@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Allocators.h"
+
+using namespace miv;
+
+/*
+ * Обработчик запросов: на каждый запрос строится буфер из 500..1500
+ * элементов через push_back, используется и выбрасывается. Выделений памяти
+ * на запрос и время:
+ *   Vector / std::vector  - каждый запрос растит буфер заново 8 -> 16 -> ...;
+ *   RecyclingAllocator    - блоки каждого размера берутся из пула потока,
+ *                           но рост с переносом элементов остаётся;
+ *   from_pool + release   - буфер прошлого запроса целиком: ни выделений,
+ *                           ни переносов.
+ */
+
+static std::size_t g_allocs = 0;
+
+void *operator new(std::size_t n)
+{
+	++g_allocs;
+	if (void *p = std::malloc(n ? n : 1))
+		return p;
+	throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int requests = 200000;
+
+volatile std::size_t sink;
+
+template <typename T>
+T make(std::size_t i);
+template <>
+int make<int>(std::size_t i)
+{
+	return int(i);
+}
+template <>
+std::string make<std::string>(std::size_t i)
+{
+	return std::string(8 + i % 8, char('a' + i % 26));
+}
+
+// Размеры запросов заранее, одинаковые для всех вариантов
+const std::vector<std::size_t> &sizes()
+{
+	static const std::vector<std::size_t> s = [] {
+		std::mt19937 rng(7);
+		std::vector<std::size_t> v(requests);
+		for (auto &n : v)
+			n = 500 + rng() % 1001;
+		return v;
+	}();
+	return s;
+}
+
+// Fill(n) строит, заполняет и выбрасывает буфер одного запроса
+template <typename Fill>
+void run(const char *name, int count, Fill fill)
+{
+	const auto &ns = sizes();
+	std::size_t before = g_allocs;
+	auto t0 = Clock::now();
+	for (int r = 0; r < count; ++r)
+		fill(ns[r]);
+	double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	std::printf("%-44s %8.2f allocs/request %9.2f ms\n", name, double(g_allocs - before) / count, ms);
+}
+
+template <typename V>
+void fill_one(V &v, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i)
+		v.push_back(make<typename V::value_type>(i));
+	sink = v.size();
+}
+
+template <typename T>
+void suite(const char *type, int count)
+{
+	std::printf("-- %s, %d requests\n", type, count);
+	run("std::vector", count, [](std::size_t n) {
+		std::vector<T> v;
+		fill_one(v, n);
+	});
+	run("Vector", count, [](std::size_t n) {
+		Vector<T> v;
+		fill_one(v, n);
+	});
+	run("Vector<T, RecyclingAllocator<T>>", count, [](std::size_t n) {
+		Vector<T, RecyclingAllocator<T>> v;
+		fill_one(v, n);
+	});
+	run("Vector(from_pool) + release_to_pool()", count, [](std::size_t n) {
+		Vector<T> v(from_pool);
+		fill_one(v, n);
+		v.release_to_pool();
+	});
+	trim_capacity_pools();
+}
+
+auto main() -> int
+{
+	suite<int>("int", requests);
+	// Строки до 16 символов - в SSO: учитываются только буферы вектора
+	suite<std::string>("std::string (SSO)", requests / 10);
+	return 0;
+}
@@ -0,0 +1,53 @@
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../ConcurrentVector.h"
+
+using namespace miv;
+
+/*
+ * Пропускная способность параллельного добавления: ConcurrentVector против
+ * miv::Vector под глобальным std::mutex, от 1 до N потоков.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t per_thread = 2000000;
+
+template <typename Push>
+double run_threads(unsigned threads, Push push)
+{
+	std::vector<std::thread> pool;
+	auto t0 = Clock::now();
+	for (unsigned t = 0; t < threads; ++t)
+		pool.emplace_back([&, t] {
+			for (std::size_t i = 0; i < per_thread; ++i)
+				push(t, i);
+		});
+	for (auto &th : pool)
+		th.join();
+	double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+	return double(threads * per_thread) / sec / 1e6;
+}
+
+auto main() -> int
+{
+	unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+	std::printf("%-8s %22s %22s\n", "threads", "ConcurrentVector Mops", "mutex+Vector Mops");
+	for (unsigned threads = 1; threads <= std::max(hw, 4u); threads *= 2)
+	{
+		ConcurrentVector<std::size_t> cv;
+		double lock_free = run_threads(threads, [&](unsigned t, std::size_t i) { cv.push_back(t * per_thread + i); });
+
+		Vector<std::size_t> v;
+		std::mutex m;
+		double locked = run_threads(threads, [&](unsigned t, std::size_t i) {
+			std::lock_guard<std::mutex> lock(m);
+			v.push_back(t * per_thread + i);
+		});
+		std::printf("%-8u %22.2f %22.2f\n", threads, lock_free, locked);
+	}
+	return 0;
+}
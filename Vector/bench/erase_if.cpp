@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * Вытеснение из кэша: удалить все записи старше порога (~30%).
+ *   erase loop     - erase(pos) на каждую запись, O(k*n); только на 100K
+ *   erase_if       - один проход с move-присваиванием, O(n)
+ *   erase_unordered - swap-and-pop, O(k), порядок не сохраняется
+ * Записи с std::string, чтобы перенос не сводился к memmove.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Entry
+{
+	std::uint64_t key;
+	std::uint32_t last_used;
+	std::string value;
+};
+
+Vector<Entry> make_cache(std::size_t n)
+{
+	Vector<Entry> v;
+	v.reserve(n);
+	std::uint64_t x = 88172645463325252ull;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+		v.push_back({ i, static_cast<std::uint32_t>(x % 100), "value-of-some-length-" + std::to_string(i) });
+	}
+	return v;
+}
+
+constexpr std::uint32_t threshold = 30;
+
+template <typename F>
+double time_ms(std::size_t n, F f)
+{
+	Vector<Entry> v = make_cache(n);
+	auto t0 = Clock::now();
+	f(v);
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+auto main() -> int
+{
+	auto loop = [](Vector<Entry> &v) {
+		for (std::size_t i = 0; i < v.size();)
+		{
+			if (v[i].last_used < threshold)
+				v.erase(v.begin() + i);
+			else
+				++i;
+		}
+	};
+	auto sweep = [](Vector<Entry> &v) {
+		erase_if(v, [](const Entry &e) { return e.last_used < threshold; });
+	};
+	auto unordered = [](Vector<Entry> &v) {
+		for (std::size_t i = 0; i < v.size();)
+		{
+			if (v[i].last_used < threshold)
+				v.erase_unordered(v.begin() + i);
+			else
+				++i;
+		}
+	};
+
+	std::printf("%-16s %10s %12s\n", "method", "entries", "ms");
+	for (std::size_t n : { std::size_t(100000), std::size_t(10000000) })
+	{
+		if (n <= 100000)
+			std::printf("%-16s %10zu %12.2f\n", "erase loop", n, time_ms(n, loop));
+		std::printf("%-16s %10zu %12.2f\n", "erase_if", n, time_ms(n, sweep));
+		std::printf("%-16s %10zu %12.2f\n", "erase_unordered", n, time_ms(n, unordered));
+	}
+	return 0;
+}
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * Побайтовые пути для тривиально копируемых T: заполнение (memset для
+ * однобайтовых и нулевых значений), копирование (memcpy), сравнение
+ * (memcmp для is_bitwise_comparable и беззнаковых байтов) против
+ * std::vector. Размеры блоков меньше порога mmap в miv::Allocator, чтобы
+ * мерить копирование, а не первые обращения к свежим страницам.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Pod
+{
+	std::int32_t x, y, z, w;
+
+	bool operator==(const Pod &o) const { return x == o.x && y == o.y && z == o.z && w == o.w; }
+	bool operator<(const Pod &o) const { return x < o.x || (x == o.x && (y < o.y || (y == o.y && (z < o.z || (z == o.z && w < o.w))))); }
+};
+
+template <>
+struct miv::is_bitwise_comparable<Pod> : std::true_type
+{
+};
+
+constexpr std::size_t bytes = 256 * 1024;
+constexpr int reps = 2000;
+
+volatile std::size_t sink;
+
+template <typename F>
+double ns_per_op(F f)
+{
+	f();
+	auto t0 = Clock::now();
+	for (int r = 0; r < reps; ++r)
+		f();
+	return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / reps;
+}
+
+template <typename V, typename T>
+void run_ops(T zero, T one, double (&out)[6])
+{
+	constexpr std::size_t n = bytes / sizeof(T);
+	V src(n, one);
+	V other(src);
+	V dst;
+	out[0] = ns_per_op([&] {
+		V v(n, zero);
+		sink = v.size();
+	});
+	out[1] = ns_per_op([&] {
+		V v(n, one);
+		sink = v.size();
+	});
+	out[2] = ns_per_op([&] {
+		V v(src);
+		sink = v.size();
+	});
+	out[3] = ns_per_op([&] {
+		dst = src;
+		sink = dst.size();
+	});
+	out[4] = ns_per_op([&] { sink = (src == other); });
+	out[5] = ns_per_op([&] { sink = (src < other); });
+}
+
+template <typename T>
+void run(const char *type, T zero, T one)
+{
+	static const char *ops[] = { "fill 0", "fill", "copy ctor", "copy assign", "==", "<" };
+	double m[6], s[6];
+	run_ops<Vector<T>>(zero, one, m);
+	run_ops<std::vector<T>>(zero, one, s);
+	for (int i = 0; i < 6; ++i)
+		std::printf("%-8s %-12s %12.0f %12.0f %8.2f\n", type, ops[i], m[i], s[i], m[i] / s[i]);
+}
+
+auto main() -> int
+{
+	std::printf("%-8s %-12s %12s %12s %8s\n", "type", "op", "miv ns", "std ns", "ratio");
+	run<int>("int", 0, 7);
+	run<unsigned char>("uchar", 0, 7);
+	run<Pod>("pod16", Pod{}, Pod{ 1, 2, 3, 4 });
+	return 0;
+}
@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include "../FixedVector.h"
+#include "../SmallVector.h"
+
+using namespace miv;
+
+/*
+ * Ограниченные выборки на горячем пути: на каждый запрос приходит от 0 до
+ * 24 кандидатов (заранее сгенерированных), берутся первые 16, результат
+ * копируется в историю запросов. Меряется только цена контейнера: против
+ * SmallVector<int, 16>, Vector<int> с reserve и std::vector. FixedVector
+ * не трогает кучу вовсе, а для int копируется как POD.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int queries = 2000000;
+constexpr std::size_t limit = 16;
+constexpr int window = 4096;
+
+struct Pool
+{
+	int ids[window][24];
+	int count[window];
+
+	Pool()
+	{
+		std::uint32_t x = 2463534242u;
+		for (int w = 0; w < window; ++w)
+		{
+			for (int &id : ids[w])
+			{
+				x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+				id = int(x >> 8);
+			}
+			count[w] = int(x % 25);
+		}
+	}
+};
+
+const Pool pool;
+
+template <typename V, typename Add>
+void run(const char *name, Add add)
+{
+	std::vector<V> history(1024);
+	long long checksum = 0;
+	auto t0 = Clock::now();
+	for (int q = 0; q < queries; ++q)
+	{
+		V picked;
+		const int *ids = pool.ids[q % window];
+		for (int c = 0, n = pool.count[q % window]; c < n; ++c)
+			if (!add(picked, ids[c]))
+				break;
+		checksum += picked.size() ? picked[picked.size() / 2] : 0;
+		history[q & 1023] = picked;
+	}
+	double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	std::printf("%-28s %10.2f ms (%lld)\n", name, ms, checksum);
+}
+
+auto main() -> int
+{
+	std::printf("%-28s %13s\n", "container", "time");
+	run<FixedVector<int, limit>>("FixedVector<int,16>", [](auto &v, int id) {
+		return v.try_push_back(id) != nullptr;
+	});
+	run<SmallVector<int, limit>>("SmallVector<int,16>", [](auto &v, int id) {
+		if (v.size() == limit)
+			return false;
+		v.push_back(id);
+		return true;
+	});
+	run<Vector<int>>("Vector<int> + reserve", [](auto &v, int id) {
+		if (v.size() == limit)
+			return false;
+		if (v.empty())
+			v.reserve(limit);
+		v.push_back(id);
+		return true;
+	});
+	run<std::vector<int>>("std::vector<int> + reserve", [](auto &v, int id) {
+		if (v.size() == limit)
+			return false;
+		if (v.empty())
+			v.reserve(limit);
+		v.push_back(id);
+		return true;
+	});
+	return 0;
+}
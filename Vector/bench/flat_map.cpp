@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+#include "../FlatMap.h"
+
+using namespace miv;
+
+/*
+ * FlatSet/FlatMap против std::set/std::map на случайных 64-битных ключах:
+ *   lookup - 4M поисков (половина промахов) в наборе из 1K (L1), 64K (L2)
+ *            и 4M (память) ключей; для сравнения std::lower_bound по тем
+ *            же отсортированным ключам (с ветвлениями);
+ *   build  - вставка n ключей по одному, одним диапазоном и 16 пачками
+ *            (до 1M ключей - лучшее из 5 прогонов).
+ * FlatSet поштучно - только до 64K: каждая вставка сдвигает хвост.
+ */
+
+using Clock = std::chrono::steady_clock;
+using Key = std::uint64_t;
+
+volatile std::size_t sink;
+
+// Лучшее из reps прогонов
+template <typename F>
+double ms(F f, int reps = 1)
+{
+	double best = 0;
+	for (int r = 0; r < reps; ++r)
+	{
+		auto t0 = Clock::now();
+		f();
+		double t = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+		best = r == 0 ? t : std::min(best, t);
+	}
+	return best;
+}
+
+Vector<Key> random_keys(std::size_t n, unsigned seed)
+{
+	std::mt19937_64 rng(seed);
+	Vector<Key> v;
+	v.reserve(n);
+	for (std::size_t i = 0; i < n; ++i)
+		v.push_back(rng() | 1);
+	return v;
+}
+
+// Половина запросов - ключи набора, половина - чётные, их нет
+Vector<Key> queries(const Vector<Key> &keys, std::size_t q)
+{
+	std::mt19937_64 rng(42);
+	Vector<Key> v;
+	v.reserve(q);
+	for (std::size_t i = 0; i < q; ++i)
+		v.push_back(i % 2 ? keys[rng() % keys.size()] : rng() & ~Key(1));
+	return v;
+}
+
+template <typename S>
+double lookup_ms(const S &s, const Vector<Key> &qs)
+{
+	return ms([&] {
+		std::size_t hits = 0;
+		for (Key q : qs)
+			hits += s.count(q);
+		sink = hits;
+	});
+}
+
+template <typename M>
+double map_lookup_ms(const M &m, const Vector<Key> &qs)
+{
+	return ms([&] {
+		std::size_t sum = 0;
+		for (Key q : qs)
+		{
+			auto it = m.find(q);
+			if (it != m.end())
+				sum += it->second;
+		}
+		sink = sum;
+	});
+}
+
+void lookups(std::size_t n)
+{
+	const std::size_t q = std::size_t(4) << 20;
+	Vector<Key> keys = random_keys(n, 1);
+	Vector<Key> qs = queries(keys, q);
+
+	std::set<Key> set(keys.begin(), keys.end());
+	FlatSet<Key> flat(keys.begin(), keys.end());
+	FlatSet<Key, std::less<Key>, EytzingerSearch> eyt(keys.begin(), keys.end());
+	double lb = ms([&] {
+		std::size_t hits = 0;
+		for (Key k : qs)
+		{
+			auto it = std::lower_bound(flat.begin(), flat.end(), k);
+			hits += it != flat.end() && *it == k;
+		}
+		sink = hits;
+	});
+
+	std::map<Key, std::uint32_t> map;
+	FlatMap<Key, std::uint32_t> fmap;
+	FlatMap<Key, std::uint32_t, std::less<Key>, EytzingerSearch> emap;
+	for (std::size_t i = 0; i < n; ++i)
+		map.emplace(keys[i], std::uint32_t(i));
+	fmap.insert(map.begin(), map.end());
+	emap.insert(map.begin(), map.end());
+
+	std::printf("lookup %-9zu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n", n, lookup_ms(set, qs), lb,
+				lookup_ms(flat, qs), lookup_ms(eyt, qs), map_lookup_ms(map, qs), map_lookup_ms(fmap, qs),
+				map_lookup_ms(emap, qs));
+}
+
+void builds(std::size_t n)
+{
+	Vector<Key> keys = random_keys(n, 2);
+	const std::size_t batches = 16;
+	const int reps = n < (std::size_t(1) << 20) ? 5 : 1;
+
+	double set_ms = ms([&] {
+		std::set<Key> s;
+		for (Key k : keys)
+			s.insert(k);
+		sink = s.size();
+	}, reps);
+	double one_ms = -1;
+	if (n <= (std::size_t(64) << 10))
+		one_ms = ms([&] {
+			FlatSet<Key> s;
+			for (Key k : keys)
+				s.insert(k);
+			sink = s.size();
+		}, reps);
+	double range_ms = ms([&] {
+		FlatSet<Key> s(keys.begin(), keys.end());
+		sink = s.size();
+	}, reps);
+	double batch_ms = ms([&] {
+		FlatSet<Key> s;
+		for (std::size_t b = 0; b < batches; ++b)
+			s.insert(keys.begin() + b * n / batches, keys.begin() + (b + 1) * n / batches);
+		sink = s.size();
+	}, reps);
+	double eyt_ms = ms([&] {
+		FlatSet<Key, std::less<Key>, EytzingerSearch> s;
+		for (std::size_t b = 0; b < batches; ++b)
+			s.insert(keys.begin() + b * n / batches, keys.begin() + (b + 1) * n / batches);
+		sink = s.size();
+	}, reps);
+	std::printf("build  %-9zu %10.2f %10.2f %10.2f %10.2f %10.2f\n", n, set_ms, one_ms, range_ms, batch_ms, eyt_ms);
+}
+
+auto main() -> int
+{
+	std::printf("%-16s %10s %10s %10s %10s %10s %10s %10s   (ms, 4M queries)\n", "", "std::set", "lower_bnd",
+				"FlatSet", "Eytzinger", "std::map", "FlatMap", "FlatMap/E");
+	for (std::size_t n : { std::size_t(1) << 10, std::size_t(64) << 10, std::size_t(4) << 20 })
+		lookups(n);
+	std::printf("\n%-16s %10s %10s %10s %10s %10s   (ms, -1 = skipped)\n", "", "std::set", "one-by-1", "range",
+				"16 batches", "Eytz 16b");
+	for (std::size_t n : { std::size_t(1) << 10, std::size_t(64) << 10, std::size_t(4) << 20 })
+		builds(n);
+	return 0;
+}
@@ -0,0 +1,123 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * Политики роста Vector на типичных сценариях: число переаллокаций
+ * (смен capacity) и пиковый RSS. Каждый прогон - в отдельном процессе
+ * (fork), пиковый RSS берётся из getrusage потомка.
+ *   big    - один вектор, 16M uint64 через push_back
+ *   small  - 200k маленьких векторов 16-байтных записей, длины ~ Geom(1/48)
+ *   bursts - append_range пачками по 1..1000 int до 8M элементов
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Record
+{
+	std::uint64_t key, value;
+};
+
+struct Result
+{
+	std::size_t reallocs;
+	double ms;
+};
+
+template <typename V, typename T>
+void push(V &v, const T &x, std::size_t &reallocs)
+{
+	std::size_t cap = v.capacity();
+	v.push_back(x);
+	reallocs += v.capacity() != cap;
+}
+
+template <typename G>
+Result big()
+{
+	Result r{ 0, 0 };
+	auto t0 = Clock::now();
+	Vector<std::uint64_t, Allocator<std::uint64_t>, G> v;
+	for (std::uint64_t i = 0; i < (std::uint64_t(1) << 24); ++i)
+		push(v, i, r.reallocs);
+	r.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	return r;
+}
+
+template <typename G>
+Result small()
+{
+	Result r{ 0, 0 };
+	std::mt19937 rng(1);
+	std::geometric_distribution<int> len(1.0 / 48);
+	auto t0 = Clock::now();
+	Vector<Vector<Record, Allocator<Record>, G>> all(200000);
+	for (auto &v : all)
+		for (int i = 0, n = len(rng); i < n; ++i)
+			push(v, Record{ std::uint64_t(i), 0 }, r.reallocs);
+	r.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	return r;
+}
+
+template <typename G>
+Result bursts()
+{
+	Result r{ 0, 0 };
+	std::mt19937 rng(2);
+	Vector<int> burst(1000, 7);
+	auto t0 = Clock::now();
+	Vector<int, Allocator<int>, G> v;
+	while (v.size() < (std::size_t(1) << 23))
+	{
+		std::size_t cap = v.capacity();
+		std::size_t n = 1 + rng() % 1000;
+		v.append_range(burst.begin(), burst.begin() + n);
+		r.reallocs += v.capacity() != cap;
+	}
+	r.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	return r;
+}
+
+// Запуск в дочернем процессе: печатает строку, пиковый RSS берёт у потомка
+template <typename F>
+void isolated(const char *policy, const char *scenario, F run)
+{
+	std::fflush(stdout);
+	pid_t pid = ::fork();
+	if (pid == 0)
+	{
+		Result r = run();
+		struct rusage ru;
+		::getrusage(RUSAGE_SELF, &ru);
+		std::printf("%-12s %-8s %10zu %12.1f %10.1f\n", policy, scenario, r.reallocs, double(ru.ru_maxrss) / 1024, r.ms);
+		std::fflush(stdout);
+		::_exit(0);
+	}
+	int status = 0;
+	::waitpid(pid, &status, 0);
+}
+
+template <typename G>
+void policy(const char *name)
+{
+	isolated(name, "big", big<G>);
+	isolated(name, "small", small<G>);
+	isolated(name, "bursts", bursts<G>);
+}
+
+auto main() -> int
+{
+	std::printf("%-12s %-8s %10s %12s %10s\n", "policy", "pattern", "reallocs", "peak RSS MB", "ms");
+	policy<DoublingGrowth<>>("2x");
+	policy<OneAndHalfGrowth<>>("1.5x");
+	policy<SizeClassGrowth<>>("size-class");
+	policy<PageGrowth<>>("page");
+	policy<DoublingGrowth<64>>("2x init=64");
+	return 0;
+}
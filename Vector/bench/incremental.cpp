@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include "../IncrementalVector.h"
+
+using namespace miv;
+
+/*
+ * Гистограмма задержек одиночного push_back при росте до 64M элементов:
+ * Vector со std::allocator (удвоение с копированием всего буфера),
+ * Vector с miv::Allocator (удвоение через mremap) и IncrementalVector
+ * (перенос по Step элементов на каждой вставке). Перцентили - верхние
+ * границы бакетов-степеней двойки, max - точный.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t N = std::size_t(1) << 26;
+constexpr int buckets = 40;
+
+struct Histogram
+{
+	std::uint64_t count[buckets] = {};
+	std::uint64_t max = 0;
+
+	void add(std::uint64_t ns)
+	{
+		int b = 0;
+		while (b + 1 < buckets && (std::uint64_t(1) << b) < ns)
+			++b;
+		++count[b];
+		max = std::max(max, ns);
+	}
+
+	std::uint64_t percentile(double p) const
+	{
+		std::uint64_t total = 0, seen = 0;
+		for (auto c : count)
+			total += c;
+		for (int b = 0; b < buckets; ++b)
+		{
+			seen += count[b];
+			if (double(seen) >= p * double(total))
+				return std::uint64_t(1) << b;
+		}
+		return max;
+	}
+};
+
+template <typename V>
+void run(const char *name)
+{
+	Histogram h;
+	V v;
+	auto start = Clock::now();
+	for (std::size_t i = 0; i < N; ++i)
+	{
+		auto t0 = Clock::now();
+		v.push_back(i);
+		auto t1 = Clock::now();
+		h.add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+	}
+	double total = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	std::printf("%-24s %8llu %8llu %8llu %8llu %12.3f %10.1f\n", name,
+				(unsigned long long)h.percentile(0.5), (unsigned long long)h.percentile(0.99),
+				(unsigned long long)h.percentile(0.999), (unsigned long long)h.percentile(0.9999),
+				double(h.max) / 1e6, total);
+}
+
+auto main() -> int
+{
+	std::printf("%-24s %8s %8s %8s %8s %12s %10s\n", "", "p50 ns", "p99 ns", "p99.9 ns", "p99.99", "max ms", "total ms");
+	run<Vector<std::uint64_t, std::allocator<std::uint64_t>>>("Vector std::allocator");
+	run<Vector<std::uint64_t>>("Vector miv::Allocator");
+	run<IncrementalVector<std::uint64_t, std::allocator<std::uint64_t>>>("Incremental std::alloc");
+	run<IncrementalVector<std::uint64_t>>("Incremental miv::Alloc");
+	return 0;
+}
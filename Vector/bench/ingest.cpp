@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <list>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * Массовая загрузка: конструктор/assign/append_range от forward-диапазона
+ * (один reserve) против цикла push_back, и буфер приёма: resize против
+ * resize_default_init / resize_and_overwrite.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure_ms(F &&f)
+{
+	auto t0 = Clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+auto main() -> int
+{
+	const std::size_t n = 4000000;
+	std::list<int> src;
+	for (std::size_t i = 0; i < n; ++i)
+		src.push_back(int(i));
+	std::deque<int> dq(src.begin(), src.end());
+	Vector<int> flat(src.begin(), src.end());
+	std::size_t sink = 0;
+
+	std::printf("%-34s %10s\n", "operation", "time");
+	std::printf("%-34s %7.2f ms\n", "push_back loop from list", measure_ms([&] {
+					Vector<int> v;
+					for (int x : src)
+						v.push_back(x);
+					sink += v.capacity();
+				}));
+	std::printf("%-34s %7.2f ms\n", "range ctor from list", measure_ms([&] {
+					Vector<int> v(src.begin(), src.end());
+					sink += v.capacity();
+				}));
+	std::printf("%-34s %7.2f ms\n", "push_back loop from deque", measure_ms([&] {
+					Vector<int> v;
+					for (int x : dq)
+						v.push_back(x);
+					sink += v.capacity();
+				}));
+	std::printf("%-34s %7.2f ms\n", "range ctor from deque", measure_ms([&] {
+					Vector<int> v(dq.begin(), dq.end());
+					sink += v.capacity();
+				}));
+	std::printf("%-34s %7.2f ms\n", "range ctor from Vector", measure_ms([&] {
+					Vector<int> v(flat.begin(), flat.end());
+					sink += v.capacity();
+				}));
+	std::printf("%-34s %7.2f ms\n", "append_range x4 chunks", measure_ms([&] {
+					Vector<int> v;
+					for (std::size_t c = 0; c < 4; ++c)
+						v.append_range(flat.begin() + c * (n / 4), flat.begin() + (c + 1) * (n / 4));
+					sink += v.capacity();
+				}));
+
+	// приём пакетов: буфер растёт и сразу перезаписывается
+	const std::size_t packet = 1 << 16, packets = 4096;
+	Vector<unsigned char> payload(packet, 0xAB);
+	std::printf("%-34s %7.2f ms\n", "resize + memcpy", measure_ms([&] {
+					Vector<unsigned char> buf;
+					for (std::size_t p = 0; p < packets; ++p)
+					{
+						std::size_t old = buf.size();
+						buf.resize(old + packet);
+						std::memcpy(buf.data() + old, payload.data(), packet);
+					}
+					sink += buf.size();
+				}));
+	std::printf("%-34s %7.2f ms\n", "resize_default_init + memcpy", measure_ms([&] {
+					Vector<unsigned char> buf;
+					for (std::size_t p = 0; p < packets; ++p)
+					{
+						std::size_t old = buf.size();
+						buf.resize_default_init(old + packet);
+						std::memcpy(buf.data() + old, payload.data(), packet);
+					}
+					sink += buf.size();
+				}));
+	std::printf("%-34s %7.2f ms\n", "resize_and_overwrite", measure_ms([&] {
+					Vector<unsigned char> buf;
+					for (std::size_t p = 0; p < packets; ++p)
+						buf.resize_and_overwrite(buf.size() + packet, [&](unsigned char *d, std::size_t cap) {
+							std::memcpy(d + cap - packet, payload.data(), packet);
+							return cap;
+						});
+					sink += buf.size();
+				}));
+	std::printf("(%zu)\n", sink);
+	return 0;
+}
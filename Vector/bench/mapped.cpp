@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdio>
+#include "../MappedVector.h"
+
+using namespace miv;
+
+/*
+ * Загрузка большого массива записей при старте: чтение файла в Vector
+ * (fread в буфер без обнуления) против MappedVector в режиме read_only.
+ * Время до готовности и время полного прохода (для mmap сюда входят
+ * page fault'ы). Файл лежит в page cache - меряется копирование, не диск.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Record
+{
+	std::uint64_t id;
+	double value;
+};
+
+constexpr std::size_t N = std::size_t(1) << 23; // 128 MiB
+
+double ms_since(Clock::time_point t0)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+template <typename C>
+double scan(const C &c)
+{
+	double s = 0;
+	for (std::size_t i = 0; i < c.size(); ++i)
+		s += c[i].value;
+	return s;
+}
+
+auto main() -> int
+{
+	const char *path = "mapped_bench.bin";
+	{
+		MappedVector<Record> out(path, MapMode::read_write);
+		out.reserve(N);
+		for (std::size_t i = 0; i < N; ++i)
+			out.push_back(Record{ i, double(i % 100) });
+		out.flush();
+	}
+
+	auto t0 = Clock::now();
+	Vector<Record> loaded;
+	loaded.resize_and_overwrite(N, [&](Record *d, std::size_t n) {
+		std::FILE *f = std::fopen(path, "rb");
+		std::size_t got = f ? std::fread(d, sizeof(Record), n, f) : 0;
+		if (f)
+			std::fclose(f);
+		return got;
+	});
+	double read_open = ms_since(t0);
+	t0 = Clock::now();
+	double s1 = scan(loaded);
+	double read_scan = ms_since(t0);
+
+	t0 = Clock::now();
+	MappedVector<Record> mapped(path);
+	double map_open = ms_since(t0);
+	t0 = Clock::now();
+	double s2 = scan(mapped);
+	double map_scan = ms_since(t0);
+
+	std::printf("%-14s %12s %12s\n", "", "open ms", "scan ms");
+	std::printf("%-14s %12.2f %12.2f\n", "fread+Vector", read_open, read_scan);
+	std::printf("%-14s %12.2f %12.2f\n", "MappedVector", map_open, map_scan);
+	if (s1 != s2)
+		std::printf("mismatch!\n");
+	std::remove(path);
+	return 0;
+}
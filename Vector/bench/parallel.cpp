@@ -0,0 +1,67 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include "../Parallel.h"
+
+using namespace miv;
+
+/*
+ * Масштабирование miv::parallel по числу исполнителей (1..N): for_each,
+ * reduce и sort на больших векторах. Колонка "std" - последовательный
+ * std-алгоритм на тех же данных.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t N = std::size_t(1) << 23;
+
+template <typename F>
+double measure(F f)
+{
+	auto t0 = Clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+auto main() -> int
+{
+	Vector<double> data(N);
+	Vector<int> keys(N);
+	std::mt19937 rng(42);
+	for (std::size_t i = 0; i < N; ++i)
+	{
+		data[i] = double(i % 1000) + 0.5;
+		keys[i] = static_cast<int>(rng());
+	}
+
+	auto heavy = [](double &x) { x = std::sqrt(x) * 1.0001 + std::sin(x); };
+
+	Vector<double> d = data;
+	double seq_each = measure([&] { std::for_each(d.begin(), d.end(), heavy); });
+	double seq_sum = 0;
+	double seq_reduce = measure([&] { seq_sum = std::accumulate(data.begin(), data.end(), 0.0); });
+	Vector<int> k = keys;
+	double seq_sort = measure([&] { std::sort(k.begin(), k.end()); });
+	std::printf("%-10s %12s %12s %12s\n", "executors", "for_each ms", "reduce ms", "sort ms");
+	std::printf("%-10s %12.2f %12.2f %12.2f\n", "std", seq_each, seq_reduce, seq_sort);
+
+	unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned t = 1; t <= std::max(hw, 4u); t *= 2)
+	{
+		parallel::ThreadPool pool(t - 1);
+		parallel::Options opt{ &pool };
+
+		d = data;
+		double each = measure([&] { parallel::for_each(d, heavy, opt); });
+		double sum = 0;
+		double reduce = measure([&] { sum = parallel::reduce(data, 0.0, std::plus<>(), opt); });
+		k = keys;
+		double sort = measure([&] { parallel::sort(k, std::less<>(), opt); });
+		if (!std::is_sorted(k.begin(), k.end()) || std::fabs(sum - seq_sum) > 1e-6 * seq_sum)
+			std::printf("mismatch!\n");
+		std::printf("%-10u %12.2f %12.2f %12.2f\n", t, each, reduce, sort);
+	}
+	return 0;
+}
@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdio>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * rank/select на битовой маске присутствия: с build_index() и линейным
+ * проходом по словам. Плюс стоимость инкрементального пересчёта после push_back.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static std::uint64_t rng_state = 0x2545F4914F6CDD1Dull;
+static std::uint64_t next_rand()
+{
+	rng_state ^= rng_state << 13, rng_state ^= rng_state >> 7, rng_state ^= rng_state << 17;
+	return rng_state;
+}
+
+template <typename F>
+double ns_per_query(std::size_t queries, F &&f)
+{
+	auto t0 = Clock::now();
+	for (std::size_t q = 0; q < queries; ++q)
+		f();
+	return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / double(queries);
+}
+
+auto main() -> int
+{
+	const std::size_t n = std::size_t(64) << 20;
+	Vector<bool> bits(n);
+	for (std::size_t i = 0; i < n; ++i)
+		if (next_rand() % 3 == 0)
+			bits[i] = true;
+	const std::size_t ones = bits.count();
+	std::size_t sink = 0;
+
+	double rank_scan = ns_per_query(200, [&] { sink += bits.rank(next_rand() % n); });
+	double select_scan = ns_per_query(200, [&] { sink += bits.select(next_rand() % ones); });
+
+	auto t0 = Clock::now();
+	bits.build_index();
+	double build_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+	double rank_ix = ns_per_query(5000000, [&] { sink += bits.rank(next_rand() % n); });
+	double select_ix = ns_per_query(5000000, [&] { sink += bits.select(next_rand() % ones); });
+	double append_rank = ns_per_query(1000000, [&] {
+		bits.push_back(next_rand() & 1);
+		sink += bits.rank(bits.size());
+	});
+
+	std::printf("bits: %zu, ones: %zu, index build: %.2f ms\n", n, ones, build_ms);
+	std::printf("%-22s %12s %12s\n", "query", "scan", "index");
+	std::printf("%-22s %9.1f ns %9.1f ns\n", "rank", rank_scan, rank_ix);
+	std::printf("%-22s %9.1f ns %9.1f ns\n", "select", select_scan, select_ix);
+	std::printf("%-22s %12s %9.1f ns\n", "push_back + rank", "-", append_rank);
+	std::printf("(%zu)\n", sink);
+	return 0;
+}
@@ -0,0 +1,59 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * Рост больших trivially relocatable векторов: miv::Allocator (mremap для
+ * mmap-блоков) против аллокатора без try_expand/reallocate (allocate + memcpy).
+ */
+
+template <typename T>
+struct PlainAllocator : std::allocator<T>
+{
+	template <typename U>
+	struct rebind
+	{
+		using other = PlainAllocator<U>;
+	};
+	PlainAllocator() noexcept = default;
+	template <typename U>
+	PlainAllocator(const PlainAllocator<U> &) noexcept {}
+};
+
+using Clock = std::chrono::steady_clock;
+
+template <typename A>
+double push_back_ms(std::size_t n)
+{
+	auto t0 = Clock::now();
+	Vector<double, A> v;
+	for (std::size_t i = 0; i < n; ++i)
+		v.push_back(double(i));
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+template <typename A>
+double reserve_steps_ms(std::size_t n)
+{
+	Vector<double, A> v(n, 1.0);
+	auto t0 = Clock::now();
+	for (std::size_t cap = n * 2; cap <= n * 8; cap *= 2)
+		v.reserve(cap);
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+auto main() -> int
+{
+	std::printf("%-32s %14s %14s\n", "operation", "miv::Allocator", "plain");
+	for (std::size_t n : {std::size_t(1) << 20, std::size_t(1) << 23, std::size_t(1) << 25})
+	{
+		std::printf("push_back %-22zu %11.2f ms %11.2f ms\n", n,
+					push_back_ms<Allocator<double>>(n), push_back_ms<PlainAllocator<double>>(n));
+		std::printf("reserve x2..x8 from %-12zu %11.2f ms %11.2f ms\n", n,
+					reserve_steps_ms<Allocator<double>>(n), reserve_steps_ms<PlainAllocator<double>>(n));
+	}
+	return 0;
+}
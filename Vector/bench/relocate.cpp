@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * Сравнение побайтового переноса (is_trivially_relocatable) с поэлементным
+ * construct + destroy в reserve / insert / emplace / erase.
+ */
+
+struct Pod
+{
+	double a, b, c, d;
+};
+
+// Тот же POD, но с принудительно отключённым trivially relocatable путём
+struct PodLoop
+{
+	double a, b, c, d;
+};
+
+struct Holder
+{
+	std::unique_ptr<int> p;
+	double payload[3];
+};
+
+struct HolderLoop
+{
+	std::unique_ptr<int> p;
+	double payload[3];
+};
+
+namespace miv
+{
+	template <>
+	struct is_trivially_relocatable<PodLoop> : std::false_type
+	{
+	};
+	template <>
+	struct is_trivially_relocatable<Holder> : std::true_type
+	{
+	};
+}
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure_ms(F &&f)
+{
+	auto t0 = Clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+template <typename T>
+T make(int i)
+{
+	if constexpr (std::is_same_v<T, Holder> || std::is_same_v<T, HolderLoop>)
+		return T{std::make_unique<int>(i), {double(i), 0, 0}};
+	else
+		return T{double(i), 0, 0, 0};
+}
+
+template <typename T>
+double bench_growth(std::size_t n)
+{
+	return measure_ms([&] {
+		for (int rep = 0; rep < 10; ++rep)
+		{
+			Vector<T> v;
+			for (std::size_t i = 0; i < n; ++i)
+				v.push_back(make<T>(int(i)));
+		}
+	});
+}
+
+template <typename T>
+double bench_front_insert_erase(std::size_t n)
+{
+	Vector<T> v;
+	for (std::size_t i = 0; i < n; ++i)
+		v.push_back(make<T>(int(i)));
+	return measure_ms([&] {
+		for (int rep = 0; rep < 500; ++rep)
+		{
+			v.emplace(v.begin(), make<T>(rep));
+			v.erase(v.begin());
+		}
+	});
+}
+
+template <typename T>
+double bench_range_erase(std::size_t n)
+{
+	return measure_ms([&] {
+		Vector<T> v;
+		for (std::size_t i = 0; i < n; ++i)
+			v.push_back(make<T>(int(i)));
+		while (v.size() > 64)
+			v.erase(v.begin(), v.begin() + 64);
+	});
+}
+
+template <typename Fast, typename Slow, typename F>
+void row(const char *name, F &&f)
+{
+	double fast = f(Fast{}), slow = f(Slow{});
+	std::printf("%-28s %10.2f ms %10.2f ms %8.2fx\n", name, fast, slow, slow / fast);
+}
+
+auto main() -> int
+{
+	const std::size_t n = 200000;
+	std::printf("%-28s %13s %13s %9s\n", "operation", "relocate", "elementwise", "speedup");
+
+	row<Pod, PodLoop>("pod push_back growth", [&](auto t) { return bench_growth<decltype(t)>(n); });
+	row<Pod, PodLoop>("pod front emplace+erase", [&](auto t) { return bench_front_insert_erase<decltype(t)>(n); });
+	row<Pod, PodLoop>("pod range erase", [&](auto t) { return bench_range_erase<decltype(t)>(n / 4); });
+
+	row<Holder, HolderLoop>("unique_ptr push_back growth", [&](auto t) { return bench_growth<decltype(t)>(n); });
+	row<Holder, HolderLoop>("unique_ptr front emplace+erase", [&](auto t) { return bench_front_insert_erase<decltype(t)>(n); });
+	row<Holder, HolderLoop>("unique_ptr range erase", [&](auto t) { return bench_range_erase<decltype(t)>(n / 4); });
+
+	return 0;
+}
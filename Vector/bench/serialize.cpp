@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include "../Serialize.h"
+
+using namespace miv;
+
+/*
+ * Сохранение и загрузка 128 MiB double: поэлементная запись/чтение через
+ * поток против снимка save()/load() (кадры по 1 MiB прямо из data()).
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t N = std::size_t(1) << 24;
+
+template <typename F>
+double measure(F f)
+{
+	auto t0 = Clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+auto main() -> int
+{
+	const char *path = "serialize_bench.bin";
+	Vector<double> v(N);
+	for (std::size_t i = 0; i < N; ++i)
+		v[i] = double(i) * 0.25;
+
+	double elem_save = measure([&] {
+		std::ofstream os(path, std::ios::binary);
+		std::uint64_t n = v.size();
+		os.write(reinterpret_cast<const char *>(&n), sizeof(n));
+		for (double x : v)
+			os.write(reinterpret_cast<const char *>(&x), sizeof(x));
+	});
+	Vector<double> a;
+	double elem_load = measure([&] {
+		std::ifstream is(path, std::ios::binary);
+		std::uint64_t n = 0;
+		is.read(reinterpret_cast<char *>(&n), sizeof(n));
+		double x;
+		for (std::uint64_t i = 0; i < n && is.read(reinterpret_cast<char *>(&x), sizeof(x)); ++i)
+			a.push_back(x);
+	});
+
+	double snap_save = measure([&] {
+		std::ofstream os(path, std::ios::binary);
+		save(os, v);
+	});
+	Vector<double> b;
+	double snap_load = measure([&] {
+		std::ifstream is(path, std::ios::binary);
+		load(is, b);
+	});
+
+	std::printf("%-16s %12s %12s\n", "", "save ms", "load ms");
+	std::printf("%-16s %12.2f %12.2f\n", "per-element", elem_save, elem_load);
+	std::printf("%-16s %12.2f %12.2f\n", "snapshot", snap_save, snap_load);
+	if (!(a == v) || !(b == v))
+		std::printf("mismatch!\n");
+	std::remove(path);
+	return 0;
+}
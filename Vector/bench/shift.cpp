@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * Вставка и удаление в середине Vector против std::vector для строк:
+ *   std::string - перемещение noexcept, хвост сдвигается переносом
+ *                 (move + destroy), это не медленнее move_backward;
+ *   Legacy      - строка с перемещением без noexcept. Раньше сдвиг шёл
+ *                 через move_if_noexcept, т.е. глубоким копированием
+ *                 каждого элемента хвоста; теперь - move-присваиванием.
+ * Короткие строки (SSO) и длинные (в куче).
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t N = 20000;
+constexpr std::size_t ops = 20000;
+
+struct Legacy
+{
+	std::string s;
+
+	Legacy(std::string v) : s(std::move(v)) {}
+	Legacy(const Legacy &) = default;
+	Legacy(Legacy &&o) : s(std::move(o.s)) {}
+	Legacy &operator=(const Legacy &) = default;
+	Legacy &operator=(Legacy &&o)
+	{
+		s = std::move(o.s);
+		return *this;
+	}
+};
+
+template <typename V>
+V make(std::size_t len)
+{
+	V v;
+	v.reserve(N + ops);
+	for (std::size_t i = 0; i < N; ++i)
+		v.push_back(std::string(len, char('a' + i % 26)));
+	return v;
+}
+
+template <typename V>
+double insert_ms(std::size_t len)
+{
+	V v = make<V>(len);
+	typename V::value_type x(std::string(len, 'x'));
+	auto t0 = Clock::now();
+	for (std::size_t i = 0; i < ops; ++i)
+		v.insert(v.begin() + v.size() / 2, x);
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+template <typename V>
+double erase_ms(std::size_t len)
+{
+	V v = make<V>(len);
+	for (std::size_t i = 0; i < ops; ++i)
+		v.push_back(std::string(len, 'y'));
+	auto t0 = Clock::now();
+	for (std::size_t i = 0; i < ops; ++i)
+		v.erase(v.begin() + v.size() / 2);
+	return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+template <typename T>
+void run(const char *type)
+{
+	for (std::size_t len : { std::size_t(8), std::size_t(64) })
+	{
+		std::printf("%-8s %-8s %-6zu %12.2f %12.2f\n", type, "insert", len, insert_ms<Vector<T>>(len),
+					insert_ms<std::vector<T>>(len));
+		std::printf("%-8s %-8s %-6zu %12.2f %12.2f\n", type, "erase", len, erase_ms<Vector<T>>(len),
+					erase_ms<std::vector<T>>(len));
+	}
+}
+
+auto main() -> int
+{
+	std::printf("%-8s %-8s %-6s %12s %12s\n", "type", "op", "len", "miv ms", "std ms");
+	run<std::string>("string");
+	run<Legacy>("legacy");
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <numeric>
+#include "../Simd.h"
+
+using namespace miv;
+
+/*
+ * Пропускная способность (GB/s прочитанных данных) ядер miv::simd на
+ * каждом доступном наборе инструкций против алгоритмов STL через
+ * VectorIterator. Данные в L2 (256 KiB) и в памяти (64 MiB); искомое
+ * значение отсутствует, поэтому find и contains_any проходят весь массив.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+volatile double sink;
+
+template <typename F>
+double gbps(std::size_t bytes, F f)
+{
+	std::size_t reps = std::max<std::size_t>(1, (std::size_t(1) << 30) / bytes);
+	f();
+	auto t0 = Clock::now();
+	for (std::size_t r = 0; r < reps; ++r)
+		f();
+	double s = std::chrono::duration<double>(Clock::now() - t0).count();
+	return double(bytes) * reps / s / 1e9;
+}
+
+template <typename T>
+void run(const char *type, std::size_t bytes)
+{
+	std::size_t n = bytes / sizeof(T);
+	Vector<T> a(n), b(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		a[i] = T(i % 1000);
+		b[i] = T(i % 7);
+	}
+	const T absent = T(-1);
+	const std::initializer_list<T> needles = { T(-1), T(-2), T(-3), T(-4) };
+
+	struct Row
+	{
+		const char *op;
+		double std_gbps;
+		double simd[4];
+	} rows[6] = {};
+
+	rows[0] = { "find", gbps(bytes, [&] { sink = double(std::find(a.begin(), a.end(), absent) - a.begin()); }), {} };
+	rows[1] = { "count", gbps(bytes, [&] { sink = double(std::count(a.begin(), a.end(), absent)); }), {} };
+	rows[2] = { "minmax", gbps(bytes, [&] { sink = double(*std::minmax_element(a.begin(), a.end()).first); }), {} };
+	rows[3] = { "sum", gbps(bytes, [&] { sink = double(std::accumulate(a.begin(), a.end(), simd::sum_t<T>(0))); }), {} };
+	rows[4] = { "dot", gbps(2 * bytes, [&] { sink = double(std::inner_product(a.begin(), a.end(), b.begin(), simd::sum_t<T>(0))); }), {} };
+	rows[5] = { "contains_any",
+				gbps(bytes, [&] { sink = double(std::find_first_of(a.begin(), a.end(), needles.begin(), needles.end()) - a.begin()); }),
+				{} };
+
+	for (int level = 0; level <= int(simd::detected()); ++level)
+	{
+		simd::set_isa(simd::Isa(level));
+		rows[0].simd[level] = gbps(bytes, [&] { sink = double(simd::find(a, absent) - a.begin()); });
+		rows[1].simd[level] = gbps(bytes, [&] { sink = double(simd::count(a, absent)); });
+		rows[2].simd[level] = gbps(bytes, [&] { sink = double(simd::minmax(a).first); });
+		rows[3].simd[level] = gbps(bytes, [&] { sink = double(simd::sum(a)); });
+		rows[4].simd[level] = gbps(2 * bytes, [&] { sink = double(simd::dot(a, b)); });
+		rows[5].simd[level] = gbps(bytes, [&] { sink = double(simd::contains_any(a, needles)); });
+	}
+	simd::set_isa(simd::detected());
+
+	for (const Row &r : rows)
+	{
+		std::printf("%-7s %-8zu %-13s %8.2f", type, bytes >> 10, r.op, r.std_gbps);
+		for (int level = 0; level <= int(simd::detected()); ++level)
+			std::printf(" %8.2f", r.simd[level]);
+		std::printf("\n");
+	}
+}
+
+auto main() -> int
+{
+	std::printf("%-7s %-8s %-13s %8s", "type", "KiB", "op", "std");
+	for (int level = 0; level <= int(simd::detected()); ++level)
+		std::printf(" %8s", simd::isa_name(simd::Isa(level)));
+	std::printf("   (GB/s)\n");
+	for (std::size_t bytes : { std::size_t(256) << 10, std::size_t(64) << 20 })
+	{
+		run<std::int32_t>("int32", bytes);
+		run<float>("float", bytes);
+		run<double>("double", bytes);
+	}
+	return 0;
+}
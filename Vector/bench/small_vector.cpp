@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "../SmallVector.h"
+
+using namespace miv;
+
+/*
+ * Количество выделений памяти и время: miv::Vector против miv::SmallVector<T, 16>
+ * на коротких векторах (до 16 элементов), как в обработчиках запросов.
+ */
+
+static std::size_t g_allocs = 0;
+
+void *operator new(std::size_t n)
+{
+	++g_allocs;
+	if (void *p = std::malloc(n ? n : 1))
+		return p;
+	throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+struct Point
+{
+	double x, y;
+	Point(double x_, double y_) : x(x_), y(y_) {}
+};
+
+using Clock = std::chrono::steady_clock;
+
+template <typename V, typename Make>
+void run(const char *name, std::size_t elems, Make make)
+{
+	const int requests = 200000;
+	std::size_t before = g_allocs;
+	double checksum = 0;
+	auto t0 = Clock::now();
+	for (int r = 0; r < requests; ++r)
+	{
+		V v;
+		for (std::size_t i = 0; i < elems; ++i)
+			v.push_back(make(r + int(i)));
+		V copy(v);
+		checksum += double(copy.size());
+	}
+	double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	std::printf("%-34s %3zu elems %10.2f allocs/request %9.2f ms (%g)\n", name, elems,
+				double(g_allocs - before) / requests, ms, checksum);
+}
+
+auto main() -> int
+{
+	auto make_int = [](int i) { return i; };
+	auto make_point = [](int i) { return Point(i, -i); };
+	for (std::size_t n : {4, 12, 16, 40})
+	{
+		run<Vector<int>>("Vector<int>", n, make_int);
+		run<SmallVector<int, 16>>("SmallVector<int, 16>", n, make_int);
+		run<Vector<Point>>("Vector<Point>", n, make_point);
+		run<SmallVector<Point, 16>>("SmallVector<Point, 16>", n, make_point);
+	}
+	return 0;
+}
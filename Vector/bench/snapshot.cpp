@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include "../SnapshotVector.h"
+
+using namespace miv;
+
+/*
+ * Читатели таблицы маршрутов из 4096 ключей (обращение по индексу и
+ * двоичный поиск) при писателе, который раз в миллисекунду перестраивает
+ * таблицу:
+ *   SnapshotVector - read() без блокировок, писатель публикует новый Vector;
+ *   shared_mutex   - shared_lock на каждый поиск, писатель перестраивает
+ *                    таблицу под unique_lock.
+ * Суммарно по всем читателям, млн поисков в секунду. Потоков больше, чем
+ * ядер, - тоже: так видно, что читатель SnapshotVector не ждёт писателя.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t table_size = 4096;
+constexpr auto run_time = std::chrono::milliseconds(300);
+
+volatile std::size_t sink;
+
+Vector<unsigned> make_table(unsigned version)
+{
+	Vector<unsigned> t;
+	t.reserve(table_size);
+	for (unsigned i = 0; i < table_size; ++i)
+		t.push_back(2 * i + (version & 1));
+	return t;
+}
+
+// index - одно обращение по индексу (цена входа в чтение видна целиком),
+// search - двоичный поиск
+bool lookup_index(const Vector<unsigned> &t, unsigned key)
+{
+	return t[key % table_size] == key;
+}
+
+bool lookup_search(const Vector<unsigned> &t, unsigned key)
+{
+	return std::binary_search(t.begin(), t.end(), key);
+}
+
+// Читатели крутят read(key) до остановки; писатель вызывает write(version)
+template <typename Read, typename Write>
+double mops(unsigned readers, Read read, Write write)
+{
+	std::atomic<bool> stop{ false };
+	std::atomic<std::size_t> total{ 0 };
+	Vector<std::thread> threads;
+	for (unsigned r = 0; r < readers; ++r)
+		threads.emplace_back([&, r] {
+			std::size_t n = 0, hits = 0;
+			unsigned key = r * 7919;
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				hits += read(key % (2 * table_size));
+				key += 40503;
+				++n;
+			}
+			total.fetch_add(n, std::memory_order_relaxed);
+			sink = hits;
+		});
+	std::thread writer([&] {
+		for (unsigned v = 1; !stop.load(std::memory_order_relaxed); ++v)
+		{
+			write(v);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	auto t0 = Clock::now();
+	std::this_thread::sleep_for(run_time);
+	stop.store(true);
+	for (auto &t : threads)
+		t.join();
+	writer.join();
+	double s = std::chrono::duration<double>(Clock::now() - t0).count();
+	return double(total.load()) / s / 1e6;
+}
+
+template <bool (*Lookup)(const Vector<unsigned> &, unsigned)>
+void run(const char *op, unsigned readers)
+{
+	SnapshotVector<unsigned> snap(make_table(0));
+	double rcu = mops(
+		readers, [&](unsigned key) { return Lookup(*snap.read(), key); },
+		[&](unsigned v) { snap.publish(make_table(v)); });
+
+	Vector<unsigned> table = make_table(0);
+	std::shared_mutex m;
+	double rw = mops(
+		readers,
+		[&](unsigned key) {
+			std::shared_lock<std::shared_mutex> lock(m);
+			return Lookup(table, key);
+		},
+		[&](unsigned v) {
+			Vector<unsigned> next = make_table(v);
+			std::unique_lock<std::shared_mutex> lock(m);
+			table.swap(next);
+		});
+	std::printf("%-8u %-8s %16.2f %16.2f\n", readers, op, rcu, rw);
+}
+
+auto main() -> int
+{
+	unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+	std::printf("hardware threads: %u\n%-8s %-8s %16s %16s   (Mlookups/s)\n", hw, "readers", "op", "SnapshotVector",
+				"shared_mutex");
+	for (unsigned readers = 1; readers <= std::max(8u, 2 * hw); readers *= 2)
+	{
+		run<lookup_index>("index", readers);
+		run<lookup_search>("search", readers);
+	}
+	return 0;
+}
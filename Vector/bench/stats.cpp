@@ -0,0 +1,58 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include "../Stats.h"
+
+using namespace miv;
+
+/*
+ * Цена политики статистики: заполнение 1000 векторов по 100K int через
+ * push_back и вставки в середину с NoStats и с Stats<Tag>. NoStats
+ * не меняет ни размер Vector, ни код горячего цикла; Stats добавляет
+ * атомарные инкременты только на выделениях и переносах.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct bench_site
+{
+	static constexpr const char *name = "bench.stats";
+};
+
+using Plain = Vector<int>;
+using Tracked = Vector<int, Allocator<int>, DoublingGrowth<>, Stats<bench_site>>;
+static_assert(sizeof(Plain) == sizeof(Tracked), "stats policy must not change the layout");
+
+constexpr int vectors = 1000;
+constexpr int N = 100000;
+
+template <typename V>
+double run()
+{
+	auto t0 = Clock::now();
+	long long sum = 0;
+	for (int k = 0; k < vectors; ++k)
+	{
+		V v;
+		for (int i = 0; i < N; ++i)
+			v.push_back(i);
+		v.insert(v.begin() + v.size() / 2, 16, k);
+		sum += v[v.size() / 2];
+	}
+	double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	if (sum == 42)
+		std::printf("!");
+	return ms;
+}
+
+auto main() -> int
+{
+	double plain = run<Plain>();
+	double tracked = run<Tracked>();
+	std::printf("%-10s %10s\n", "policy", "ms");
+	std::printf("%-10s %10.2f\n", "NoStats", plain);
+	std::printf("%-10s %10.2f (%+.1f%%)\n", "Stats<Tag>", tracked, (tracked / plain - 1) * 100);
+	StatsRegistry::instance().dump_json(std::cout);
+	std::cout << "\n";
+	return 0;
+}
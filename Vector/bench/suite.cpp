@@ -0,0 +1,422 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../Vector.h"
+
+using namespace miv;
+
+/*
+ * Сводный бенчмарк miv::Vector против std::vector по всем основным
+ * операциям и нескольким типам элементов: int, std::string (вне SSO),
+ * 128-байтный POD и тип с пользовательским копированием (не trivially
+ * relocatable). Отдельно - Vector<bool> против std::vector<bool>.
+ *
+ * Вывод - CSV в stdout, по строке на (тип, операцию):
+ *   type,op,n,miv_ns,std_ns,ratio
+ * miv_ns / std_ns - лучшее из нескольких повторов время одной операции
+ * в наносекундах, ratio = miv_ns / std_ns (меньше 1 - miv быстрее).
+ * Флаг --quick уменьшает размеры в 64 раза (для проверки в ctest).
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static volatile std::uint64_t sink;
+
+struct Big
+{
+	std::uint64_t w[16];
+	friend bool operator==(const Big &a, const Big &b) { return std::memcmp(a.w, b.w, sizeof(a.w)) == 0; }
+	friend bool operator<(const Big &a, const Big &b) { return a.w[0] < b.w[0]; }
+};
+
+// Копирование с пользовательским кодом (запоминает свой адрес): переносится
+// только поэлементно
+struct Node
+{
+	std::uint64_t value;
+	Node *self;
+
+	Node(std::uint64_t v = 0) noexcept : value(v), self(this) {}
+	Node(const Node &o) noexcept : value(o.value), self(this) {}
+	Node &operator=(const Node &o) noexcept
+	{
+		value = o.value;
+		return *this;
+	}
+	friend bool operator==(const Node &a, const Node &b) { return a.value == b.value; }
+	friend bool operator<(const Node &a, const Node &b) { return a.value < b.value; }
+};
+
+template <typename T>
+T make(std::size_t i);
+template <>
+int make<int>(std::size_t i) { return static_cast<int>(i * 2654435761u); }
+template <>
+std::string make<std::string>(std::size_t i) { return "element-with-a-long-name-" + std::to_string(i); }
+template <>
+Big make<Big>(std::size_t i)
+{
+	Big b;
+	for (std::size_t k = 0; k < 16; ++k)
+		b.w[k] = i + k;
+	return b;
+}
+template <>
+Node make<Node>(std::size_t i) { return Node(i); }
+
+inline std::uint64_t key(int v) { return static_cast<std::uint64_t>(v); }
+inline std::uint64_t key(const std::string &s) { return s.size(); }
+inline std::uint64_t key(const Big &b) { return b.w[0]; }
+inline std::uint64_t key(const Node &n) { return n.value; }
+
+struct Config
+{
+	std::size_t n;		 // размер для линейных операций
+	std::size_t inserts; // число вставок/удалений в начало и середину
+	int reps;
+};
+
+// Лучшее из reps прогонов, нс на одну из ops операций. setup() готовит
+// состояние вне замера, run() - измеряемая часть
+template <typename Setup, typename Run>
+double measure(int reps, std::size_t ops, Setup setup, Run run)
+{
+	double best = 1e300;
+	for (int r = 0; r < reps; ++r)
+	{
+		auto state = setup();
+		auto t0 = Clock::now();
+		run(state);
+		double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+		best = std::min(best, ns);
+	}
+	return best / double(ops ? ops : 1);
+}
+
+template <typename F>
+double measure(int reps, std::size_t ops, F run)
+{
+	return measure(reps, ops, [] { return 0; }, [&](int) { run(); });
+}
+
+void report(const char *type, const char *op, std::size_t n, double miv_ns, double std_ns)
+{
+	std::printf("%s,%s,%zu,%.3f,%.3f,%.3f\n", type, op, n, miv_ns, std_ns, miv_ns / std_ns);
+}
+
+// Одна операция для обеих реализаций: F<V>::run возвращает нс на операцию
+template <typename T, typename V>
+struct Ops
+{
+	const Config &c;
+	std::vector<T> src;
+
+	explicit Ops(const Config &cfg) : c(cfg)
+	{
+		src.reserve(c.n);
+		for (std::size_t i = 0; i < c.n; ++i)
+			src.push_back(make<T>(i));
+	}
+
+	V filled() const { return V(src.begin(), src.end()); }
+
+	double push_back(bool reserve) const
+	{
+		return measure(c.reps, c.n, [&] {
+			V v;
+			if (reserve)
+				v.reserve(c.n);
+			for (std::size_t i = 0; i < c.n; ++i)
+				v.push_back(src[i]);
+			sink = v.size();
+		});
+	}
+
+	double emplace_back(bool reserve) const
+	{
+		return measure(c.reps, c.n, [&] {
+			V v;
+			if (reserve)
+				v.reserve(c.n);
+			for (std::size_t i = 0; i < c.n; ++i)
+				v.emplace_back(make<T>(i));
+			sink = v.size();
+		});
+	}
+
+	// middle = false - вставка в начало
+	double insert(bool middle) const
+	{
+		return measure(
+			c.reps, c.inserts, [&] { return V(src.begin(), src.begin() + c.inserts); },
+			[&](V &v) {
+				for (std::size_t i = 0; i < c.inserts; ++i)
+					v.insert(v.begin() + (middle ? v.size() / 2 : 0), src[i]);
+				sink = v.size();
+			});
+	}
+
+	double erase(bool middle) const
+	{
+		return measure(
+			c.reps, c.inserts, [&] { return V(src.begin(), src.begin() + 2 * c.inserts); },
+			[&](V &v) {
+				for (std::size_t i = 0; i < c.inserts; ++i)
+					v.erase(v.begin() + (middle ? v.size() / 2 : 0));
+				sink = v.size();
+			});
+	}
+
+	double range_ctor() const
+	{
+		return measure(c.reps, c.n, [&] {
+			V v(src.begin(), src.end());
+			sink = v.size();
+		});
+	}
+
+	double assign() const
+	{
+		return measure(
+			c.reps, c.n, [&] { return filled(); },
+			[&](V &v) {
+				v.assign(src.rbegin(), src.rend());
+				sink = v.size();
+			});
+	}
+
+	double copy() const
+	{
+		V from = filled();
+		return measure(c.reps, c.n, [&] {
+			V v(from);
+			sink = v.size();
+		});
+	}
+
+	// O(1): повторяем, чтобы время было измеримым
+	double move() const
+	{
+		constexpr std::size_t rounds = 1000;
+		V a = filled();
+		return measure(c.reps, rounds, [&] {
+			for (std::size_t i = 0; i < rounds; ++i)
+			{
+				V b(std::move(a));
+				a = std::move(b);
+			}
+			sink = a.size();
+		});
+	}
+
+	double iterate() const
+	{
+		V v = filled();
+		return measure(c.reps, c.n, [&] {
+			std::uint64_t s = 0;
+			for (const T &x : v)
+				s += key(x);
+			sink = s;
+		});
+	}
+
+	double index() const
+	{
+		V v = filled();
+		return measure(c.reps, c.n, [&] {
+			std::uint64_t s = 0;
+			for (std::size_t i = 0; i < v.size(); ++i)
+				s += key(v[i]);
+			sink = s;
+		});
+	}
+
+	double equal() const
+	{
+		V a = filled(), b = filled();
+		return measure(c.reps, c.n, [&] { sink = a == b; });
+	}
+
+	double less() const
+	{
+		V a = filled(), b = filled();
+		return measure(c.reps, c.n, [&] { sink = a < b; });
+	}
+};
+
+template <typename T>
+void run_type(const char *type, const Config &c)
+{
+	Ops<T, Vector<T>> m(c);
+	Ops<T, std::vector<T>> s(c);
+	report(type, "push_back", c.n, m.push_back(false), s.push_back(false));
+	report(type, "push_back_reserved", c.n, m.push_back(true), s.push_back(true));
+	report(type, "emplace_back", c.n, m.emplace_back(false), s.emplace_back(false));
+	report(type, "emplace_back_reserved", c.n, m.emplace_back(true), s.emplace_back(true));
+	report(type, "insert_front", c.inserts, m.insert(false), s.insert(false));
+	report(type, "insert_middle", c.inserts, m.insert(true), s.insert(true));
+	report(type, "erase_front", c.inserts, m.erase(false), s.erase(false));
+	report(type, "erase_middle", c.inserts, m.erase(true), s.erase(true));
+	report(type, "range_ctor", c.n, m.range_ctor(), s.range_ctor());
+	report(type, "assign", c.n, m.assign(), s.assign());
+	report(type, "copy", c.n, m.copy(), s.copy());
+	report(type, "move", c.n, m.move(), s.move());
+	report(type, "iterate", c.n, m.iterate(), s.iterate());
+	report(type, "index", c.n, m.index(), s.index());
+	report(type, "equal", c.n, m.equal(), s.equal());
+	report(type, "less", c.n, m.less(), s.less());
+}
+
+// Vector<bool> и std::vector<bool>: у miv нет итераторов, поэтому для
+// count/find/логических операций std::vector<bool> работает идиоматично
+// (std::count, цикл по индексам), а miv - словами
+template <typename V>
+V bits(std::size_t n)
+{
+	V v(n, false);
+	for (std::size_t i = 0; i < n; i += 3)
+		v[i] = true;
+	return v;
+}
+
+void run_bool(const Config &c)
+{
+	using MV = Vector<bool>;
+	using SV = std::vector<bool>;
+	const std::size_t n = c.n * 16;
+	const char *type = "bool";
+
+	auto push = [&](auto tag, bool reserve) {
+		using V = decltype(tag);
+		return measure(c.reps, n, [&] {
+			V v;
+			if (reserve)
+				v.reserve(n);
+			for (std::size_t i = 0; i < n; ++i)
+				v.push_back(i % 3 == 0);
+			sink = v.size();
+		});
+	};
+	report(type, "push_back", n, push(MV(), false), push(SV(), false));
+	report(type, "push_back_reserved", n, push(MV(), true), push(SV(), true));
+
+	auto fill_ctor = [&](auto tag) {
+		using V = decltype(tag);
+		return measure(c.reps, n, [&] {
+			V v(n, true);
+			sink = v.size();
+		});
+	};
+	report(type, "fill_ctor", n, fill_ctor(MV()), fill_ctor(SV()));
+
+	auto read = [&](auto tag) {
+		using V = decltype(tag);
+		const V v = bits<V>(n);
+		return measure(c.reps, n, [&] {
+			std::uint64_t s = 0;
+			for (std::size_t i = 0; i < n; ++i)
+				s += v[i];
+			sink = s;
+		});
+	};
+	report(type, "read", n, read(MV()), read(SV()));
+
+	auto write = [&](auto tag) {
+		using V = decltype(tag);
+		return measure(
+			c.reps, n, [&] { return V(n, false); },
+			[&](V &v) {
+				for (std::size_t i = 0; i < n; ++i)
+					v[i] = (i & 5) != 0;
+				sink = v.size();
+			});
+	};
+	report(type, "write", n, write(MV()), write(SV()));
+
+	{
+		MV m = bits<MV>(n);
+		SV s = bits<SV>(n);
+		report(type, "count", n, measure(c.reps, n, [&] { sink = m.count(); }),
+			   measure(c.reps, n, [&] { sink = static_cast<std::uint64_t>(std::count(s.begin(), s.end(), true)); }));
+		report(type, "find_all", n,
+			   measure(c.reps, n, [&] {
+				   std::uint64_t k = 0;
+				   for (auto i = m.find_first(); i != MV::npos; i = m.find_next(i))
+					   ++k;
+				   sink = k;
+			   }),
+			   measure(c.reps, n, [&] {
+				   std::uint64_t k = 0;
+				   for (std::size_t i = 0; i < n; ++i)
+					   k += s[i];
+				   sink = k;
+			   }));
+		report(type, "flip", n, measure(c.reps, n, [&] { m.flip(); }), measure(c.reps, n, [&] { s.flip(); }));
+		report(type, "set_range", n, measure(c.reps, n, [&] { m.set_range(1, n - 1); }),
+			   measure(c.reps, n, [&] { std::fill(s.begin() + 1, s.end() - 1, true); }));
+
+		MV m2 = bits<MV>(n);
+		SV s2 = bits<SV>(n);
+		report(type, "and", n, measure(c.reps, n, [&] { m &= m2; }), measure(c.reps, n, [&] {
+				   for (std::size_t i = 0; i < n; ++i)
+					   s[i] = s[i] && s2[i];
+			   }));
+		report(type, "xor", n, measure(c.reps, n, [&] { m ^= m2; }), measure(c.reps, n, [&] {
+				   for (std::size_t i = 0; i < n; ++i)
+					   s[i] = s[i] != s2[i];
+			   }));
+		report(type, "copy", n, measure(c.reps, n, [&] {
+				   MV v(m);
+				   sink = v.size();
+			   }),
+			   measure(c.reps, n, [&] {
+				   SV v(s);
+				   sink = v.size();
+			   }));
+		MV m3(m);
+		SV s3(s);
+		report(type, "equal", n, measure(c.reps, n, [&] { sink = m == m3; }),
+			   measure(c.reps, n, [&] { sink = s == s3; }));
+	}
+
+	auto resize = [&](auto tag) {
+		using V = decltype(tag);
+		return measure(c.reps, n, [&] {
+			V v;
+			for (std::size_t k = 1; k <= 64; ++k)
+				v.resize(n * k / 64, k % 2 == 0);
+			sink = v.size();
+		});
+	};
+	report(type, "resize", n, resize(MV()), resize(SV()));
+
+	auto pop = [&](auto tag) {
+		using V = decltype(tag);
+		return measure(
+			c.reps, n, [&] { return bits<V>(n); },
+			[&](V &v) {
+				while (v.size())
+					v.pop_back();
+				sink = v.size();
+			});
+	};
+	report(type, "pop_back", n, pop(MV()), pop(SV()));
+}
+
+auto main(int argc, char **argv) -> int
+{
+	bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+	Config c{ std::size_t(1) << 18, 2048, 5 };
+	if (quick)
+		c = { c.n / 64, c.inserts / 64, 1 };
+
+	std::printf("type,op,n,miv_ns,std_ns,ratio\n");
+	run_type<int>("int", c);
+	run_type<std::string>("string", c);
+	run_type<Big>("big_pod", c);
+	run_type<Node>("node", c);
+	run_bool(c);
+	return 0;
+}
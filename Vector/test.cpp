@@ -1,8 +1,29 @@
 #include <iostream>
 #include "Vector.h"
+#include "SmallVector.h"
+#include "Allocators.h"
+#include "ConcurrentVector.h"
+#include "Parallel.h"
+#include "MappedVector.h"
+#include "Serialize.h"
+#include "IncrementalVector.h"
+#include "SoAVector.h"
+#include "Stats.h"
+#include "Simd.h"
+#include "FixedVector.h"
+#include "FlatMap.h"
+#include "SnapshotVector.h"
 #include <algorithm>
+#include <numeric>
 #include <vector>
 #include <string>
+#include <memory>
+#include <list>
+#include <tuple>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <thread>
 
 using namespace miv;
 
@@ -21,7 +42,36 @@ struct Point {
 	}
 };
 
-auto main() -> std::uint32_t {
+// Тег места для статистики Vector
+struct stats_demo {
+	static constexpr const char* name = "test.stats_demo";
+};
+
+// Тип с unique_ptr: перемещается memcpy-переносом после явной специализации
+struct Owner {
+	std::unique_ptr<int> value;
+};
+template <> struct miv::is_trivially_relocatable<Owner> : std::true_type {};
+
+// Таблица простых чисел, собранная при компиляции
+constexpr miv::FixedVector<int, 32> small_primes()
+{
+	miv::FixedVector<int, 32> p;
+	for (int n = 2; n < 60; ++n)
+	{
+		bool prime = true;
+		for (int d : p)
+			prime = prime && n % d != 0;
+		if (prime)
+			p.push_back(n);
+	}
+	return p;
+}
+constexpr auto primes_table = small_primes();
+static_assert(primes_table.size() == 17 && primes_table.back() == 59, "constexpr FixedVector");
+static_assert(std::is_trivially_copyable_v<miv::FixedVector<int, 8>>, "FixedVector<int> copies as POD");
+
+auto main() -> int {
 	// В качестве проверки работоспособности, используем генерацию последовательности квадратов + point;
 	Vector<int> squares;
 	squares.reserve(10);
@@ -76,6 +126,349 @@ auto main() -> std::uint32_t {
 	for (auto const& s : a) std::cout << s << ' ';
 	std::cout << "\n\n";
 
+	// trivially relocatable: рост буфера, вставка и удаление в начале
+	Vector<Owner> owners;
+	for (int i = 0; i < 20; ++i)
+		owners.push_back(Owner{ std::make_unique<int>(i) });
+	owners.emplace(owners.begin(), Owner{ std::make_unique<int>(-1) });
+	owners.erase(owners.begin() + 1, owners.begin() + 3);
+	std::cout << "Relocated owners: ";
+	for (auto const& o : owners) std::cout << *o.value << ' ';
+	std::cout << "\n\n";
+
+	// большой буфер растёт через mremap без копирования
+	Vector<double> big(1 << 18, 0.5);
+	big.reserve(1 << 21);
+	big.push_back(1.5);
+	std::cout << "Big vector after remap: size=" << big.size()
+		<< " front=" << big.front() << " back=" << big.back() << "\n\n";
+
+	// SmallVector: встроенный буфер и переход в heap, move/swap между состояниями
+	SmallVector<std::string, 4> small{ "a", "b" };
+	SmallVector<std::string, 4> spilled{ "1", "2", "3", "4", "5", "6" };
+	small.swap(spilled);
+	std::cout << "SmallVector after swap: inline=" << small.is_inline() << " ";
+	for (auto const& s : small) std::cout << s << ' ';
+	std::cout << "| inline=" << spilled.is_inline() << " ";
+	for (auto const& s : spilled) std::cout << s << ' ';
+	SmallVector<std::string, 4> moved(std::move(spilled));
+	moved.insert(moved.begin(), "z");
+	std::cout << "| moved: ";
+	for (auto const& s : moved) std::cout << s << ' ';
+	// вставка значения из самого вектора при полном буфере
+	SmallVector<std::string, 2> echo_small{ "one", "two" };
+	echo_small.push_back(echo_small[0]);
+	echo_small.insert(echo_small.begin(), echo_small.back());
+	echo_small.shrink_to_fit();
+	echo_small.emplace(echo_small.begin() + 1, echo_small[2]);
+	SmallVector<int, 2> ints_small{ 1, 2 };
+	ints_small.push_back(ints_small[0]);
+	ints_small.push_back(ints_small[1]);
+	SmallVector<std::string, 2> fill_small{ "a", "b", "c" };
+	fill_small.shrink_to_fit();
+	fill_small.resize(5, fill_small[0]);
+	std::cout << "| self insert: ";
+	for (auto const& s : echo_small) std::cout << s << ' ';
+	for (int x : ints_small) std::cout << x << ' ';
+	for (auto const& s : fill_small) std::cout << s << ' ';
+	std::cout << "\n\n";
+
+	// Arena / Pool: векторы остаются в своей арене при move и swap
+	Arena arena1, arena2;
+	Vector<std::string, ArenaAllocator<std::string>> in1({ "x", "y" }, ArenaAllocator<std::string>(arena1));
+	Vector<std::string, ArenaAllocator<std::string>> in2({ "p", "q", "r" }, ArenaAllocator<std::string>(arena2));
+	in1.swap(in2);
+	in2 = std::move(in1);
+	std::cout << "Arena vectors: in2 = ";
+	for (auto const& s : in2) std::cout << s << ' ';
+	std::cout << "(same arena: " << (in2.get_allocator().arena() == &arena2) << ")\n";
+	// выравнивание за конец чанка: блок берётся из нового чанка
+	Arena tight(64);
+	tight.allocate(60, 1);
+	auto *line = static_cast<char *>(tight.allocate(8, 64));
+	std::memset(line, 0, 8);
+	// чанк под крупный блок кончается невыровненным адресом
+	tight.allocate(1000, 8);
+	auto *line2 = static_cast<char *>(tight.allocate(8, 64));
+	std::memset(line2, 0, 8);
+	std::cout << "Arena over-aligned tail: aligned=" << (reinterpret_cast<std::uintptr_t>(line) % 64 == 0)
+		<< (reinterpret_cast<std::uintptr_t>(line2) % 64 == 0) << "\n";
+	Pool pool;
+	Vector<int, PoolAllocator<int>> pooled{ PoolAllocator<int>(pool) };
+	for (int i = 0; i < 100; ++i)
+		pooled.push_back(i);
+	std::cout << "Pooled vector size: " << pooled.size() << "\n\n";
+
+	// выравнивание: over-aligned тип и AlignedAllocator
+	struct alignas(64) Block { float lanes[16]; };
+	Vector<Block> blocks(3);
+	Vector<float, AlignedAllocator<float, 64>> lanes(100, 1.0f);
+	std::cout << "Aligned data: blocks % 64 = " << reinterpret_cast<std::uintptr_t>(blocks.data()) % 64
+		<< ", lanes % 64 = " << reinterpret_cast<std::uintptr_t>(lanes.data()) % 64 << "\n\n";
+
+	// Vector<bool>: пословные операции над масками
+	Vector<bool> mask(100);
+	mask.set_range(10, 20).flip(15);
+	Vector<bool> other(100, true);
+	other.reset_range(0, 12);
+	mask &= other;
+	std::cout << "Bit mask: count=" << mask.count() << " set bits: ";
+	for (auto i = mask.find_first(); i != mask.npos; i = mask.find_next(i)) std::cout << i << ' ';
+	mask.build_index();
+	mask[50] = true;
+	std::cout << "| rank(20)=" << mask.rank(20) << " select(7)=" << mask.select(7);
+	// порядок масок - по битам, как у std::vector<bool>
+	Vector<bool> ones(3, true), prefix(70, true);
+	prefix[65] = false;
+	std::cout << " | less: " << (ones < Vector<bool>(3, true)) << (ones < prefix) << (prefix < Vector<bool>(70, true))
+		<< (Vector<bool>(70, true) <= prefix) << "\n\n";
+
+	// массовая загрузка: forward-диапазон, input-итераторы, буфер без обнуления
+	std::list<int> source{ 1, 2, 3 };
+	Vector<int> ingest(source.begin(), source.end());
+	std::istringstream stream("7 8 9");
+	ingest.insert(ingest.begin() + 1, std::istream_iterator<int>(stream), std::istream_iterator<int>());
+	ingest.append_range(source.begin(), source.end());
+	Vector<char> recv;
+	recv.resize_and_overwrite(5, [](char* d, std::size_t n) { std::memcpy(d, "hello", n); return n - 1; });
+	std::cout << "Ingested: ";
+	for (auto v : ingest) std::cout << v << ' ';
+	std::cout << "| recv: " << std::string(recv.data(), recv.size()) << "\n\n";
+
+	// ConcurrentVector: добавление из нескольких потоков без блокировок
+	ConcurrentVector<int> shared;
+	std::vector<std::thread> workers;
+	for (int t = 0; t < 4; ++t)
+		workers.emplace_back([&shared, t] { for (int i = 0; i < 1000; ++i) shared.push_back(t); });
+	for (auto& w : workers) w.join();
+	std::cout << "ConcurrentVector: size=" << shared.size()
+		<< " sum=" << std::accumulate(shared.begin(), shared.end(), 0);
+	// бросивший конструктор не занимает слот
+	ConcurrentVector<std::string> labels{ "a" };
+	try
+	{
+		labels.emplace_back(std::size_t(-1), 'x');
+	}
+	catch (const std::length_error &)
+	{
+	}
+	std::cout << " | after throw: size=" << labels.size() << "\n\n";
+
+	// miv::parallel: пул из 3 рабочих + вызывающий поток
+	parallel::ThreadPool workers_pool(3);
+	parallel::Options opt{ &workers_pool, 1000 };
+	Vector<int> work(100000);
+	std::iota(work.begin(), work.end(), 0);
+	parallel::for_each(work, [](int& x) { x = 99999 - x; }, opt);
+	parallel::sort(work, std::less<>(), opt);
+	auto odd = parallel::stable_partition(work, [](int x) { return x % 2 == 0; }, opt);
+	auto erased = parallel::erase_if(work, [](int x) { return x % 3 == 0; }, opt);
+	std::cout << "Parallel: sum=" << parallel::reduce(work, 0LL, std::plus<>(), opt)
+		<< " evens=" << (odd - work.begin()) << " erased=" << erased << " front=" << work.front() << "\n\n";
+
+#ifdef MIV_HAS_MMAP
+	// MappedVector: запись в файл, затем отображение без копирования
+	{
+		MappedVector<int> file("mapped_test.bin", MapMode::read_write);
+		for (int i = 1; i <= 5; ++i) file.push_back(i * i);
+		file.flush();
+	}
+	MappedVector<int> mapped("mapped_test.bin");
+	std::cout << "MappedVector: ";
+	for (auto v : mapped) std::cout << v << ' ';
+	std::cout << "| writable=" << mapped.writable();
+	bool ro_pop = false;
+	try { mapped.pop_back(); } catch (const std::system_error &) { ro_pop = true; }
+	mapped.close();
+	std::remove("mapped_test.bin");
+	{
+		// Элемент самого вектора при росте, переносящем отображение
+		MappedVector<int> grown("mapped_test.bin", MapMode::read_write);
+		grown.resize(1, 7);
+		grown.resize(grown.capacity(), 7);
+		grown.push_back(grown[0]);
+		grown.resize(grown.capacity() + 1, grown[1]);
+		std::cout << " ro_pop throws=" << ro_pop << " self=" << (grown.back() == 7 && grown[grown.size() - 2] == 7) << "\n\n";
+	}
+	std::remove("mapped_test.bin");
+#endif
+
+	// Снимки: Vector<T> и упакованный Vector<bool> через поток
+	std::stringstream snapshot;
+	save(snapshot, squares, 16);
+	save(snapshot, mask);
+	Vector<int> restored;
+	Vector<bool> restored_mask;
+	load(snapshot, restored);
+	load(snapshot, restored_mask);
+	std::cout << "Snapshot: ints equal=" << (restored == squares)
+		<< " bits equal=" << (restored_mask == mask) << " count=" << restored_mask.count() << "\n\n";
+
+	// IncrementalVector: перенос при росте размазан по вставкам
+	IncrementalVector<std::string> gradual;
+	for (int i = 0; i < 18; ++i)
+		gradual.push_back("s" + std::to_string(i));
+	std::cout << "IncrementalVector: size=" << gradual.size() << " capacity=" << gradual.capacity()
+		<< " migrating=" << gradual.migrating() << " [9]=" << gradual[9] << " back=" << gradual.back() << "\n\n";
+
+	// Политики роста: 1.5x с классами malloc и начальной ёмкостью 20
+	Vector<char, Allocator<char>, SizeClassGrowth<20>> text;
+	std::cout << "SizeClassGrowth capacities:";
+	for (int i = 0; i < 200; ++i)
+	{
+		auto cap = text.capacity();
+		text.push_back('x');
+		if (text.capacity() != cap) std::cout << ' ' << text.capacity();
+	}
+	std::cout << "\n\n";
+
+	// SoAVector: те же точки, но x и y в отдельных колонках
+	SoAVector<double, double> points;
+	points.emplace_back(3.0, 1.0);
+	points.emplace_back(1.0, 2.0);
+	points.push_back({ 2.0, 5.0 });
+	std::sort(points.begin(), points.end());
+	double sum_x = std::accumulate(points.data<0>(), points.data<0>() + points.size(), 0.0);
+	std::cout << "SoAVector sorted by x:";
+	for (auto [x, y] : points)
+		std::cout << " (" << x << ", " << y << ")";
+	std::cout << " sum x=" << sum_x << "\n\n";
+
+	// Статистика: счётчики по тегу места и отчёт реестра в JSON
+	{
+		Vector<int, Allocator<int>, DoublingGrowth<>, Stats<stats_demo>> tracked;
+		for (int i = 0; i < 100; ++i)
+			tracked.push_back(i);
+		tracked.insert(tracked.begin(), 29, -1);
+		tracked.reserve(1000);
+	}
+	std::cout << "Stats: ";
+	StatsRegistry::instance().dump_json(std::cout);
+	std::cout << "\n\n";
+
+	// Удаление за один проход: erase_if, erase(value), erase_unordered
+	Vector<int> sweep{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	auto odd_count = erase_if(sweep, [](int x) { return x % 2 != 0; });
+	auto tens = erase(sweep, 10);
+	sweep.erase_unordered(sweep.begin());
+	std::cout << "erase_if: odd=" << odd_count << " tens=" << tens << " left:";
+	for (int x : sweep)
+		std::cout << ' ' << x;
+	std::cout << "\n\n";
+
+	// Вставка значения из самого вектора: копия снимается до сдвига и роста
+	Vector<std::string> echo{ "one", "two", "three" };
+	echo.shrink_to_fit();
+	echo.insert(echo.begin() + 1, echo.back());
+	echo.push_back(echo.front());
+	echo.erase(echo.begin() + 2);
+	std::cout << "Self insert:";
+	for (const auto &w : echo)
+		std::cout << ' ' << w;
+	std::cout << "\n\n";
+
+	// Заполнение и сравнение: memset/memcpy/memcmp для тривиальных T;
+	// resize и assign значением из самого вектора
+	Vector<unsigned char> bytes(8, 0xAB);
+	Vector<unsigned char> bytes2(bytes);
+	bytes2.back() = 0xAC;
+	Vector<int> fill{ 5, 6 };
+	fill.shrink_to_fit();
+	fill.resize(5, fill[1]);
+	fill.assign(3, fill[0]);
+	std::cout << "Fast paths: equal=" << (bytes == Vector<unsigned char>(8, 0xAB)) << " less=" << (bytes < bytes2)
+			  << " fill:";
+	for (int x : fill)
+		std::cout << ' ' << x;
+	std::cout << "\n\n";
+
+	// miv::simd: каждый доступный набор инструкций против скалярной версии
+	Vector<int> ints(1000);
+	Vector<double> reals(1000);
+	for (int i = 0; i < 1000; ++i)
+	{
+		ints[i] = (i * 7919) % 1009 - 500;
+		reals[i] = ints[i] * 0.5;
+	}
+	auto simd_probe = [&](std::size_t n) {
+		return std::make_tuple(simd::find(ints.data(), n, 123), simd::count(ints.data(), n, -3),
+							   n ? simd::minmax(ints.data(), n) : std::pair<int, int>(),
+							   simd::sum(ints.data(), n), simd::dot(ints.data(), ints.data(), n),
+							   simd::contains_any(reals.data(), n, reals.data() + 999, 1),
+							   n ? simd::max(reals.data(), n) : 0.0, simd::sum(reals.data(), n));
+	};
+	bool simd_ok = true;
+	for (int level = int(simd::Isa::sse2); level <= int(simd::detected()); ++level)
+	{
+		for (std::size_t n = 0; n <= 1000; n += 37)
+		{
+			simd::set_isa(simd::Isa::scalar);
+			auto expected = simd_probe(n);
+			simd::set_isa(simd::Isa(level));
+			simd_ok = simd_ok && simd_probe(n) == expected;
+		}
+	}
+	simd::set_isa(simd::detected());
+	std::cout << "Simd (" << simd::isa_name(simd::active()) << ") matches scalar: " << simd_ok
+			  << ", sum=" << simd::sum(ints) << " max=" << simd::max(reals) << "\n\n";
+
+	// FixedVector: ёмкость в объекте, try_push_back вместо исключения
+	FixedVector<std::string, 4> names{ "b", "d" };
+	names.insert(names.begin(), "a");
+	names.emplace(names.begin() + 2, "c");
+	bool overflow = names.try_push_back("e") == nullptr;
+	std::cout << "FixedVector:";
+	for (const auto &n : names)
+		std::cout << ' ' << n;
+	std::cout << " full=" << names.full() << " overflow=" << overflow << " primes=" << primes_table.size() << "\n\n";
+
+	// FlatSet/FlatMap: отсортированные ключи подряд, диапазон вставляется одним слиянием
+	FlatSet<int> ids{ 5, 1, 3 };
+	int batch[] = { 4, 1, 9, 2 };
+	ids.insert(std::begin(batch), std::end(batch));
+	std::cout << "FlatSet:";
+	for (int id : ids)
+		std::cout << ' ' << id;
+	std::cout << " contains(4)=" << ids.contains(4) << " lower_bound(6)=" << *ids.lower_bound(6);
+	// сравнение наборов - по их компаратору
+	FlatSet<int, std::greater<int>> desc1{ 1, 9 }, desc2{ 2, 8 };
+	std::cout << " desc less=" << (desc1 < desc2) << (desc2 < desc1) << '\n';
+	FlatMap<std::string, int, std::less<std::string>, EytzingerSearch> ages{ { "bob", 30 }, { "alice", 25 } };
+	ages["carol"] = 41;
+	ages.insert_or_assign("bob", 31);
+	std::cout << "FlatMap:";
+	for (auto [name, age] : ages)
+		std::cout << ' ' << name << '=' << age;
+	std::cout << " at(alice)=" << ages.at("alice");
+	auto retired = erase_if(ages, [](auto kv) { return kv.second > 40; });
+	std::cout << " erase_if(>40)=" << retired << " size=" << ages.size() << "\n\n";
+
+	// SnapshotVector: читатель держит снимок, писатель публикует новый
+	SnapshotVector<int> routes{ 10, 20, 30 };
+	{
+		auto before = routes.read();
+		routes.update([](Vector<int> &v) { v.push_back(40); });
+		std::cout << "SnapshotVector: old snapshot " << before.size() << " elems, new " << routes.read().size()
+				  << ", pending " << routes.reclaim();
+	}
+	routes.synchronize();
+	std::cout << ", after synchronize " << routes.reclaim() << "\n\n";
+
+	// CapacityPool: буфер обработанного запроса достаётся следующему
+	{
+		Vector<int> request;
+		for (int i = 0; i < 1000; ++i)
+			request.push_back(i);
+		const int *buf = request.data();
+		request.release_to_pool();
+		Vector<int> next(from_pool);
+		std::cout << "CapacityPool: reused=" << (next.data() == buf) << " capacity=" << next.capacity();
+		next.release_to_pool();
+		std::cout << " retained=" << capacity_pool_retained();
+		trim_capacity_pools();
+		std::cout << " after trim=" << capacity_pool_retained() << "\n\n";
+	}
+
 	// max_size и get_allocator
 	std::cout << "Max size of squares: " << squares.max_size() << "\n";
 	auto alloc = squares.get_allocator(); (void)alloc;